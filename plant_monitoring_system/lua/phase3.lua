@@ -10,45 +10,103 @@ function bytesToInt(bytes, start, size, signed)
     return val
 end
 
+-- Helper function to format a Unix epoch as "YYYY-MM-DD HH:MM:SS" (UTC)
+function epochToString(epoch)
+    if epoch == 0 then return "unknown" end
+    local days = math.floor(epoch / 86400)
+    local rem = epoch % 86400
+    local z = days + 719468
+    local era = math.floor(z / 146097)
+    local doe = z - era * 146097
+    local yoe = math.floor((doe - math.floor(doe / 1460) + math.floor(doe / 36524) - math.floor(doe / 146096)) / 365)
+    local doy = doe - (365 * yoe + math.floor(yoe / 4) - math.floor(yoe / 100))
+    local mp = math.floor((5 * doy + 2) / 153)
+    local d = doy - math.floor((153 * mp + 2) / 5) + 1
+    local m = mp < 10 and mp + 3 or mp - 9
+    local y = yoe + era * 400 + (m <= 2 and 1 or 0)
+    return string.format("%04d-%02d-%02d %02d:%02d:%02d", y, m, d,
+                         math.floor(rem / 3600), math.floor(rem / 60) % 60, rem % 60)
+end
+
+-- Alarm uplink (5 bytes): flags with bit 7 set, then the Unix epoch of the event
+function parseAlarm(appeui, deveui, bytes)
+    local flags = bytes[1] - 128
+    local freefall = flags % 2 == 1
+    local shock = math.floor(flags / 2) % 2 == 1
+    local time = epochToString(bytesToInt(bytes, 2, 4, false))
+
+    resiot_debug(string.format("ALARM: Freefall: %s, Shock: %s, Time: %s", tostring(freefall), tostring(shock), time))
+
+    resiot_setnodevalue(appeui, deveui, "Freefall", freefall and 1 or 0)
+    resiot_setnodevalue(appeui, deveui, "Shock", shock and 1 or 0)
+    resiot_setnodevalue(appeui, deveui, "AlarmTime", time)
+end
+
 function parsePayload(appeui, deveui, payload)
     -- Convert hex payload to byte array
     local bytes = resiot_hexdecode(payload)
 
-    -- 1. GPS Data (1 to 17)
-    local lat  = bytesToInt(bytes, 1, 4, true) / 1000000.0
-    local lon  = bytesToInt(bytes, 5, 4, true) / 1000000.0
-    local alt  = bytesToInt(bytes, 9, 4, true) / 100.0 
-    
-    -- GPS Time (13-15) HHMMSS
-    local hh = bytes[13]
-    local mm = bytes[14]
-    local ss = bytes[15]
-    local time = string.format("%02d:%02d:%02d", hh, mm, ss)
-
-    local sats = bytes[16]                            
-
-    -- 2. Temperature and Humidity Data (17 to 20)
-    local temp = bytesToInt(bytes, 17, 2, true) / 100.0
-    local hum  = bytesToInt(bytes, 19, 2, false) / 100.0
-
-    -- 3. Brightness and Moisture (21 to 24)
-    local light    = bytesToInt(bytes, 21, 2, false) / 10.0
-    local moisture = bytesToInt(bytes, 23, 2, false) / 10.0
-
-    -- 4. Color RGB (Offsets 25 to 27)
-    local r = bytes[25]
-    local g = bytes[26]
-    local b = bytes[27]
-
-    -- 5. Accelerometer (28 to 30)
+    -- Alarm uplinks are marked by bit 7 of the first byte (never a GPS mode)
+    if bytes[1] >= 128 then
+        parseAlarm(appeui, deveui, bytes)
+        return
+    end
+
+    -- 1. Header (1 to 6)
+    -- Mode: 0 = absolute position, 1 = delta since last report, 2 = no change
+    local mode = bytes[1]
+
+    -- Sample Time (2-5) Unix epoch, 0 if the node clock is not set
+    local epoch = bytesToInt(bytes, 2, 4, false)
+    local time = epochToString(epoch)
+
+    local sats = bytes[6]
+
+    -- 2. Temperature and Humidity Data (7 to 10)
+    local temp = bytesToInt(bytes, 7, 2, true) / 100.0
+    local hum  = bytesToInt(bytes, 9, 2, false) / 100.0
+
+    -- 3. Brightness and Moisture (11 to 14)
+    local light    = bytesToInt(bytes, 11, 2, false) / 10.0
+    local moisture = bytesToInt(bytes, 13, 2, false) / 10.0
+
+    -- 4. Color RGB (Offsets 15 to 17)
+    local r = bytes[15]
+    local g = bytes[16]
+    local b = bytes[17]
+
+    -- 5. Accelerometer (18 to 20)
     -- These are int8 (signed). If value > 127, it's negative.
     local function toInt8(b) return b > 127 and b - 256 or b end
-    local x = toInt8(bytes[28]) / 10.0
-    local y = toInt8(bytes[29]) / 10.0
-    local z = toInt8(bytes[30]) / 10.0
+    local x = toInt8(bytes[18]) / 10.0
+    local y = toInt8(bytes[19]) / 10.0
+    local z = toInt8(bytes[20]) / 10.0
+
+    -- 6. GPS Position (from 21)
+    -- Deltas and "no change" are relative to the last absolute report, kept
+    -- in the RefLatitude/RefLongitude/RefAltitude node values, so a lost
+    -- uplink does not affect the following ones
+    local lat, lon, alt
+    if mode == 0 then
+        lat = bytesToInt(bytes, 21, 4, true) / 1000000.0
+        lon = bytesToInt(bytes, 25, 4, true) / 1000000.0
+        alt = bytesToInt(bytes, 29, 4, true) / 100.0
+        resiot_setnodevalue(appeui, deveui, "RefLatitude", lat)
+        resiot_setnodevalue(appeui, deveui, "RefLongitude", lon)
+        resiot_setnodevalue(appeui, deveui, "RefAltitude", alt)
+    else
+        lat = tonumber(resiot_getnodevalue(appeui, deveui, "RefLatitude")) or 0
+        lon = tonumber(resiot_getnodevalue(appeui, deveui, "RefLongitude")) or 0
+        alt = tonumber(resiot_getnodevalue(appeui, deveui, "RefAltitude")) or 0
+        if mode == 1 then
+            lat = lat + bytesToInt(bytes, 21, 2, true) / 1000000.0
+            lon = lon + bytesToInt(bytes, 23, 2, true) / 1000000.0
+            alt = alt + bytesToInt(bytes, 25, 2, true) / 100.0
+        end
+    end
 
     -- Debug Logs
-    resiot_debug(string.format("GPS: Lat: %.6f, Long: %.6f, Alt: %.2f, Time: %s, Sats: %d", lat, lon, alt, time, sats))
+    resiot_debug(string.format("GPS: Mode: %d, Lat: %.6f, Long: %.6f, Alt: %.2f, Time: %s, Sats: %d", mode, lat, lon, alt, time, sats))
     resiot_debug(string.format("Sensors: Temp: %.2f, Hum: %.2f, Light: %.1f, Moisture: %.1f", temp, hum, light, moisture))
     resiot_debug(string.format("Color: R:%d, G:%d, B:%d", r, g, b))
     resiot_debug(string.format("Accel: X:%.1f, Y:%.1f, Z:%.1f", x, y, z))
@@ -75,8 +133,8 @@ end
 Origin = resiot_startfrom()
 
 if Origin == "Manual" then
-    -- Test payload (30 bytes hex)
-    payload = "010203040506070809101112131415161718192021222324252627282930" 
+    -- Test payload (32 bytes hex, absolute position)
+    payload = "0000B1E76808CA089411F4012C01242E1201FE6207B66802127CC7FFE8FD0000" 
     appeui = "70b3d57ed000fc4d"
     deveui = "7a39323559379194"
 else
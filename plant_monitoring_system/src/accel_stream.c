@@ -0,0 +1,194 @@
+/**
+ * @file accel_stream.c
+ * @brief Continuous accelerometer acquisition from the MMA8451Q FIFO.
+ *
+ * The INT1 edge only schedules the service work: the I2C transfers run on
+ * the system work queue. One batch reads INT_SOURCE and the latched
+ * freefall/transient sources; alarms are published first, then the FIFO is
+ * drained if it reached the watermark. INT1 stays asserted while any source
+ * is pending, so the work repeats until the pin is released, which also
+ * recovers an edge missed during a read error.
+ */
+
+#include "accel_stream.h"
+#include "channels.h"
+#include "timekeeping.h"
+#include "sensors/i2c/accel.h"
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+
+#define ACCEL_STREAM_RETRY_MS 100  /**< Delay before retrying a failed drain. */
+
+static const struct accel_stream_config *stream; /**< Active configuration. */
+static struct gpio_callback irq_cb;              /**< INT1 callback. */
+static struct k_work_delayable service_work;     /**< Services INT1 outside interrupt context. */
+
+static uint8_t fifo_buf[1 + ACCEL_FIFO_SIZE * ACCEL_XYZ_SIZE]; /**< F_STATUS + samples. */
+static struct accel_block block;                               /**< Block being published. */
+
+/**
+ * @brief Reads the interrupt sources and publishes any freefall/shock alarm.
+ *
+ * @param int_source Set to the INT_SOURCE register.
+ * @return 0 on success, negative errno code on failure.
+ */
+static int service_events(uint8_t *int_source)
+{
+    struct i2c_batch batch;
+    uint8_t ff_src, trans_src;
+
+    /* Reading the sources also clears the latched events */
+    i2c_batch_init(&batch);
+    i2c_batch_read_regs(&batch, stream->dev, ACCEL_REG_INT_SOURCE, int_source, 1);
+    i2c_batch_read_regs(&batch, stream->dev, ACCEL_REG_FF_MT_SRC, &ff_src, 1);
+    i2c_batch_read_regs(&batch, stream->dev, ACCEL_REG_TRANSIENT_SRC, &trans_src, 1);
+
+    int ret = i2c_batch_submit(&batch);
+    if (ret == 0) ret = i2c_batch_wait(&batch);
+    if (ret < 0) {
+        return ret;
+    }
+
+    struct alarm_event alarm = { .type = 0 };
+
+    if ((*int_source & ACCEL_INT_FF_MT) && (ff_src & ACCEL_FF_MT_SRC_EA)) {
+        alarm.type |= ALARM_FREEFALL;
+    }
+    if ((*int_source & ACCEL_INT_TRANS) && (trans_src & ACCEL_TRANSIENT_SRC_EA)) {
+        alarm.type |= ALARM_SHOCK;
+    }
+
+    if (alarm.type != 0) {
+        alarm.timestamp = timekeeping_now();
+        printk("[ACCEL] - Alarm 0x%02x\n", alarm.type);
+        zbus_chan_pub(&alarm_chan, &alarm, CHANNEL_TIMEOUT);
+    }
+    return 0;
+}
+
+/**
+ * @brief Drains one watermark worth of samples and publishes them.
+ *
+ * @return 0 on success, negative errno code on failure.
+ */
+static int drain_fifo(void)
+{
+    struct i2c_batch batch;
+    struct accel_sample mean = {0};
+
+    i2c_batch_init(&batch);
+    accel_queue_fifo(&batch, stream->dev, fifo_buf, stream->watermark);
+
+    int ret = i2c_batch_submit(&batch);
+    if (ret == 0) ret = i2c_batch_wait(&batch);
+    if (ret < 0) {
+        return ret;
+    }
+
+    uint8_t status = fifo_buf[0];
+
+    block.timestamp = timekeeping_now();
+    block.sample_period_us = accel_odr_period_us(stream->odr);
+    block.count = MIN(ACCEL_F_STATUS_CNT(status), stream->watermark);
+    block.overflow = (status & ACCEL_F_STATUS_OVF) != 0;
+
+    for (uint8_t i = 0; i < block.count; i++) {
+        int16_t raw[3];
+        float ms2[3];
+
+        accel_decode_xyz(&fifo_buf[1 + i * ACCEL_XYZ_SIZE], &raw[0], &raw[1], &raw[2]);
+        for (int axis = 0; axis < 3; axis++) {
+            accel_convert_to_ms2(raw[axis], stream->range, &ms2[axis]);
+        }
+
+        block.samples[i].x = (int16_t)(ms2[0] * 100);
+        block.samples[i].y = (int16_t)(ms2[1] * 100);
+        block.samples[i].z = (int16_t)(ms2[2] * 100);
+
+        mean.x += block.samples[i].x;
+        mean.y += block.samples[i].y;
+        mean.z += block.samples[i].z;
+    }
+
+    if (block.count > 0) {
+        zbus_chan_pub(&accel_block_chan, &block, CHANNEL_TIMEOUT);
+
+        mean.timestamp = block.timestamp;
+        mean.x /= block.count;
+        mean.y /= block.count;
+        mean.z /= block.count;
+        zbus_chan_pub(&accel_chan, &mean, CHANNEL_TIMEOUT);
+    }
+    return 0;
+}
+
+/**
+ * @brief Work handler: services every pending INT1 source.
+ */
+static void service_work_handler(struct k_work *work)
+{
+    uint8_t int_source;
+
+    int ret = service_events(&int_source);
+    if (ret == 0 && (int_source & ACCEL_INT_FIFO)) {
+        ret = drain_fifo();
+    }
+
+    if (ret < 0) {
+        printk("[ACCEL] - Interrupt service failed (%d)\n", ret);
+        k_work_reschedule(&service_work, K_MSEC(ACCEL_STREAM_RETRY_MS));
+    } else if (gpio_pin_get_dt(&stream->irq) > 0) {
+        /* A source is still pending: no new edge will come */
+        k_work_reschedule(&service_work, K_NO_WAIT);
+    }
+}
+
+/**
+ * @brief INT1 interrupt handler: defers the service to the work queue.
+ */
+static void accel_irq_handler(const struct device *port, struct gpio_callback *cb, uint32_t pins)
+{
+    k_work_reschedule(&service_work, K_NO_WAIT);
+}
+
+int accel_stream_start(const struct accel_stream_config *cfg)
+{
+    if (!gpio_is_ready_dt(&cfg->irq)) {
+        printk("[ACCEL] - Interrupt GPIO not ready\n");
+        return -ENODEV;
+    }
+
+    stream = cfg;
+    k_work_init_delayable(&service_work, service_work_handler);
+
+    int ret = gpio_pin_configure_dt(&cfg->irq, GPIO_INPUT);
+    if (ret < 0) {
+        return ret;
+    }
+
+    gpio_init_callback(&irq_cb, accel_irq_handler, BIT(cfg->irq.pin));
+    ret = gpio_add_callback_dt(&cfg->irq, &irq_cb);
+    if (ret < 0) {
+        return ret;
+    }
+
+    ret = gpio_pin_interrupt_configure_dt(&cfg->irq, GPIO_INT_EDGE_TO_ACTIVE);
+    if (ret < 0) {
+        return ret;
+    }
+
+    ret = accel_fifo_enable(cfg->dev, cfg->odr, cfg->watermark);
+    if (ret == 0) {
+        ret = accel_events_enable(cfg->dev, cfg->freefall_mg, cfg->freefall_count,
+                                  cfg->shock_mg, cfg->shock_count);
+    }
+    if (ret < 0) {
+        gpio_pin_interrupt_configure_dt(&cfg->irq, GPIO_INT_DISABLE);
+        return ret;
+    }
+
+    printk("[ACCEL] - Streaming %u-sample blocks every %u ms\n", cfg->watermark,
+           (unsigned int)(cfg->watermark * accel_odr_period_us(cfg->odr) / 1000));
+    return 0;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file accel_stream.h
+ * @brief Continuous accelerometer acquisition from the MMA8451Q FIFO.
+ *
+ * The accelerometer samples on its own at a fixed data rate into its
+ * 32-sample FIFO and raises INT1 when the watermark is reached. The
+ * interrupt schedules a drain that reads the whole block in one I2C burst
+ * and publishes it on @c accel_block_chan, plus the block mean on
+ * @c accel_chan for the consumers of single samples.
+ *
+ * The freefall and transient engines share INT1: their events are
+ * published on @c alarm_chan as soon as the interrupt is serviced, before
+ * the FIFO is drained.
+ */
+
+#ifndef ACCEL_STREAM_H
+#define ACCEL_STREAM_H
+
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/i2c.h>
+#include <stdint.h>
+
+/**
+ * @brief Accelerometer stream configuration.
+ */
+struct accel_stream_config {
+    const struct i2c_dt_spec *dev; /**< Accelerometer I2C descriptor. */
+    struct gpio_dt_spec irq;       /**< GPIO wired to the accelerometer INT1 pin. */
+    uint8_t range;                 /**< Full-scale range (ACCEL_2G, ...). */
+    uint8_t odr;                   /**< Output data rate (ACCEL_ODR_*). */
+    uint8_t watermark;             /**< Samples per block (1–32). */
+    uint16_t freefall_mg;          /**< Freefall threshold on every axis (mg), 0 to disable. */
+    uint8_t freefall_count;        /**< Samples below the threshold before a freefall alarm. */
+    uint16_t shock_mg;             /**< Transient threshold on any axis (mg), 0 to disable. */
+    uint8_t shock_count;           /**< Samples above the threshold before a shock alarm. */
+};
+
+/**
+ * @brief Enable the FIFO and event engines and start servicing INT1.
+ *
+ * @param cfg Stream configuration (must stay valid while streaming).
+ * @retval 0 On success.
+ * @retval -ENODEV If the interrupt GPIO is not ready.
+ * @retval Negative errno code if the accelerometer or GPIO configuration failed.
+ */
+int accel_stream_start(const struct accel_stream_config *cfg);
+
+#endif /* ACCEL_STREAM_H */
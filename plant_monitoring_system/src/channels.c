@@ -0,0 +1,57 @@
+/**
+ * @file channels.c
+ * @brief zbus channel definitions of the measurement bus.
+ *
+ * Channels are defined without observers; each consumer module attaches
+ * its own observers (see @ref channels.h).
+ */
+
+#include "channels.h"
+
+ZBUS_CHAN_DEFINE(env_chan,                    /* Name */
+                 struct env_sample,           /* Message type */
+                 NULL,                        /* Validator */
+                 NULL,                        /* User data */
+                 ZBUS_OBSERVERS_EMPTY,        /* Observers */
+                 ZBUS_MSG_INIT(0)             /* Initial value */
+);
+
+ZBUS_CHAN_DEFINE(accel_chan,
+                 struct accel_sample,
+                 NULL,
+                 NULL,
+                 ZBUS_OBSERVERS_EMPTY,
+                 ZBUS_MSG_INIT(0)
+);
+
+ZBUS_CHAN_DEFINE(accel_block_chan,
+                 struct accel_block,
+                 NULL,
+                 NULL,
+                 ZBUS_OBSERVERS_EMPTY,
+                 ZBUS_MSG_INIT(0)
+);
+
+ZBUS_CHAN_DEFINE(gps_chan,
+                 struct gps_sample,
+                 NULL,
+                 NULL,
+                 ZBUS_OBSERVERS_EMPTY,
+                 ZBUS_MSG_INIT(0)
+);
+
+ZBUS_CHAN_DEFINE(motion_chan,
+                 struct motion_event,
+                 NULL,
+                 NULL,
+                 ZBUS_OBSERVERS_EMPTY,
+                 ZBUS_MSG_INIT(0)
+);
+
+ZBUS_CHAN_DEFINE(alarm_chan,
+                 struct alarm_event,
+                 NULL,
+                 NULL,
+                 ZBUS_OBSERVERS_EMPTY,
+                 ZBUS_MSG_INIT(0)
+);
@@ -0,0 +1,111 @@
+/**
+ * @file channels.h
+ * @brief zbus channels and message types of the measurement bus.
+ *
+ * Every producer publishes typed samples on its own channel at its own
+ * rate; consumers attach themselves to the channels they need with
+ * @c ZBUS_CHAN_ADD_OBS() in their own module, so adding a consumer does not
+ * touch the producers or @c main().
+ *
+ * | Channel          | Message               | Producer                       |
+ * |------------------|-----------------------|--------------------------------|
+ * | env_chan         | @ref env_sample       | sensors thread                 |
+ * | accel_chan       | @ref accel_sample     | accel stream or sensors thread |
+ * | accel_block_chan | @ref accel_block      | accel stream                   |
+ * | gps_chan         | @ref gps_sample       | GPS thread                     |
+ * | motion_chan      | @ref motion_event     | motion monitor                 |
+ * | alarm_chan       | @ref alarm_event      | accel stream                   |
+ */
+
+#ifndef CHANNELS_H
+#define CHANNELS_H
+
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/sys/util.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define CHANNEL_TIMEOUT K_MSEC(100) /**< Maximum wait for a channel held by another thread. */
+
+/**
+ * @brief One acquisition of the environment sensors.
+ */
+struct env_sample {
+    uint32_t timestamp;   /**< Unix epoch of the sample (s), 0 if unknown. */
+
+    int32_t brightness;   /**< Ambient brightness, mean over the interval (% ×10). */
+    int32_t brightness_min; /**< Lowest brightness in the interval (% ×10). */
+    int32_t brightness_max; /**< Highest brightness in the interval (% ×10). */
+    int32_t moisture;     /**< Soil moisture, mean over the interval (% ×10). */
+    int32_t moisture_min; /**< Lowest soil moisture in the interval (% ×10). */
+    int32_t moisture_max; /**< Highest soil moisture in the interval (% ×10). */
+
+    int32_t temp;         /**< Temperature (°C ×100). */
+    int32_t hum;          /**< Relative humidity (%RH ×100). */
+
+    uint16_t red;         /**< Red color channel (raw). */
+    uint16_t green;       /**< Green color channel (raw). */
+    uint16_t blue;        /**< Blue color channel (raw). */
+    uint16_t clear;       /**< Clear color channel (raw). */
+};
+
+/**
+ * @brief One accelerometer reading.
+ */
+struct accel_sample {
+    uint32_t timestamp;   /**< Unix epoch of the sample (s), 0 if unknown. */
+    int32_t x;            /**< X-axis acceleration (m/s² ×100). */
+    int32_t y;            /**< Y-axis acceleration (m/s² ×100). */
+    int32_t z;            /**< Z-axis acceleration (m/s² ×100). */
+};
+
+#define ACCEL_BLOCK_MAX 32 /**< Samples per block (accelerometer FIFO depth). */
+
+/**
+ * @brief Block of consecutive accelerometer samples drained from the FIFO.
+ */
+struct accel_block {
+    uint32_t timestamp;        /**< Unix epoch of the last sample (s), 0 if unknown. */
+    uint32_t sample_period_us; /**< Time between consecutive samples (µs). */
+    uint8_t count;             /**< Valid entries in @c samples, oldest first. */
+    bool overflow;             /**< Samples were lost before this block. */
+    struct {
+        int16_t x;             /**< X-axis acceleration (m/s² ×100). */
+        int16_t y;             /**< Y-axis acceleration (m/s² ×100). */
+        int16_t z;             /**< Z-axis acceleration (m/s² ×100). */
+    } samples[ACCEL_BLOCK_MAX];
+};
+
+/**
+ * @brief Position reported by the GPS thread.
+ */
+struct gps_sample {
+    uint32_t time;        /**< Unix epoch of the fix (s), 0 if unknown. */
+    int32_t lat;          /**< Latitude (µdeg). */
+    int32_t lon;          /**< Longitude (µdeg). */
+    int32_t alt;          /**< Altitude (cm). */
+    uint8_t sats;         /**< Satellites used in the fix. */
+};
+
+/**
+ * @brief Motion or tilt change detected from the accelerometer.
+ */
+struct motion_event {
+    uint32_t timestamp;   /**< Unix epoch of the detection (s), 0 if unknown. */
+    uint32_t count;       /**< Number of motion events since boot. */
+};
+
+#define ALARM_FREEFALL BIT(0) /**< The node is falling. */
+#define ALARM_SHOCK    BIT(1) /**< Sudden acceleration change (knock, impact). */
+
+/**
+ * @brief Event detected by the accelerometer hardware engines.
+ */
+struct alarm_event {
+    uint32_t timestamp;   /**< Unix epoch of the detection (s), 0 if unknown. */
+    uint8_t type;         /**< ALARM_* flags. */
+};
+
+ZBUS_CHAN_DECLARE(env_chan, accel_chan, accel_block_chan, gps_chan, motion_chan, alarm_chan);
+
+#endif /* CHANNELS_H */
@@ -3,19 +3,37 @@
  * @brief Implementation of the GPS measurement thread.
  *
  * This module defines the GPS measurement thread responsible for
- * periodically acquiring GPS data, parsing it, and updating the
- * shared measurement structure with scaled integer values.
+ * periodically acquiring GPS data, parsing it, and publishing the
+ * position on the @c gps_chan zbus channel with scaled integer values.
  * 
  * ## Features:
- * - Periodic GPS polling controlled by system mode (TEST/NORMAL/ADVANCED)
- * - Thread synchronization through semaphores and poll events
+ * - Fix period of @ref system_context::report_period_ms, on the thread's
+ *   own schedule
  * - Scaled integer storage for latitude, longitude, and altitude
+ * - Receiver duty-cycling: PMTK161 standby between fixes, woken up
+ *   @ref GPS_WAKE_LEAD_MS before the next one for a hot-start fix
+ * - Time-to-fix and receiver on-time counters
+ * - HDOP-weighted averaging of the fixes of a stationary node, restarted
+ *   whenever the motion monitor reports motion on @c motion_chan
+ * - Motion gating: while the node does not move, the last fix is reused
+ *   (up to @ref system_context::gps_max_fix_age_ms) and the receiver stays
+ *   in standby
+ * - Last known good position persisted with the settings subsystem, used
+ *   when no fix is available and injected into the receiver at its first
+ *   wake-up once the clock is set
  */
 
 #include "gps_thread.h"
 #include "sensors/gps/gps.h"
+#include "timekeeping.h"
+#include "channels.h"
 #include <zephyr/kernel.h>
 #include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/settings/settings.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
 
 /* --- Thread configuration --------------------------------------------------- */
 #define GPS_THREAD_STACK_SIZE 1024  /**< Stack size allocated for the GPS thread. */
@@ -24,51 +42,405 @@
 K_THREAD_STACK_DEFINE(gps_stack, GPS_THREAD_STACK_SIZE); /**< GPS thread stack. */
 static struct k_thread gps_thread_data;                  /**< GPS thread control block. */
 
+/* --- Duty-cycle configuration ----------------------------------------------- */
+#define GPS_WAKE_LEAD_MS      10000 /**< Receiver wake-up time before the next scheduled fix. */
+#define GPS_FIX_TIMEOUT_MS    5000  /**< Maximum wait for a valid fix at the scheduled time. */
+#define GPS_EPOCH_TIMEOUT_MS  1100  /**< Maximum wait for one NMEA epoch (1 Hz fix rate + margin). */
+#define GPS_FIX_MAX_AGE_MS    1500  /**< Maximum age of a stored fix used without waiting. */
+
+/**
+ * @brief Receiver duty-cycle counters.
+ *
+ * Make the trade-off between fix freshness and receiver energy visible:
+ * time-to-fix after each wake-up and the fraction of time the receiver
+ * was kept out of standby.
+ */
+struct gps_duty_stats {
+    uint32_t wakeups;        /**< Number of standby exits. */
+    uint32_t fixes;          /**< Wake-ups that led to a valid fix. */
+    uint32_t fix_timeouts;   /**< Wake-ups without a valid fix before the request. */
+    uint32_t reused;         /**< Requests answered with the cached fix (no motion). */
+    uint32_t last_ttff_ms;   /**< Time-to-fix of the last wake-up (ms). */
+    uint64_t total_ttff_ms;  /**< Sum of time-to-fix values (ms), for the mean. */
+    uint64_t on_time_ms;     /**< Accumulated time out of standby (ms). */
+    int64_t  wake_time;      /**< Uptime of the last wake-up (ms). */
+    bool     awake;          /**< Whether the receiver is currently out of standby. */
+    bool     fixed;          /**< Whether a valid fix was obtained since the last wake-up. */
+};
+
+static struct gps_duty_stats duty; /**< Duty-cycle counters (GPS thread only). */
+
+static atomic_t aid_pending = ATOMIC_INIT(0); /**< Warm-start aiding requested by @ref gps_thread_warm_start(). */
+
+/* --- Position filter configuration ------------------------------------------ */
+#define GPS_FILTER_MAX_FIXES  32    /**< Fixes after which older samples are progressively forgotten. */
+#define GPS_FILTER_MIN_HDOP   50    /**< HDOP floor (×100) so a single fix cannot dominate the mean. */
+
+/**
+ * @brief HDOP-weighted running mean of the position of a stationary node.
+ *
+ * Each fix is weighted by 1/HDOP², so a few poor-geometry fixes barely move
+ * the estimate. Once @ref GPS_FILTER_MAX_FIXES fixes have been merged, all
+ * sums are halved, which keeps the mean responsive to slow drifts. The
+ * filter is restarted whenever the motion count on @c motion_chan changes.
+ */
+struct gps_position_filter {
+    int64_t sum_lat;       /**< Σ weight × latitude (µdeg). */
+    int64_t sum_lon;       /**< Σ weight × longitude (µdeg). */
+    int64_t sum_alt;       /**< Σ weight × altitude (cm). */
+    int64_t sum_weight;    /**< Σ weight. */
+    uint16_t count;        /**< Fixes merged since the last reset or halving. */
+    uint32_t last_seq;     /**< Sequence number of the last merged epoch. */
+    uint32_t motion;       /**< Motion counter seen at the last merged fix. */
+};
+
+static struct gps_position_filter filter; /**< Position filter (GPS thread only). */
+
+/**
+ * @brief Last valid fix published on @c gps_chan.
+ */
+struct gps_fix_cache {
+    int64_t fix_time;      /**< Uptime of the fix (ms). */
+    uint32_t motion;       /**< Motion counter seen when the fix was taken. */
+    bool valid;            /**< Whether a valid fix was obtained. */
+};
+
+static struct gps_fix_cache cache; /**< Cached fix state (GPS thread only). */
+
+static struct gps_sample position; /**< Position published on @c gps_chan (GPS thread only). */
+
+/* --- Persistence configuration ---------------------------------------------- */
+#define GPS_SETTINGS_KEY        "gps/fix"            /**< Settings key of the last known good fix. */
+#define GPS_PERSIST_MIN_UDEG    100                  /**< Position change (µdeg, ~11 m) that triggers a save. */
+#define GPS_PERSIST_INTERVAL_MS (6 * 60 * 60 * 1000) /**< Maximum interval between saves of an unchanged position. */
+
+/**
+ * @brief Last known good fix, persisted across reboots.
+ *
+ * Saves are rate limited to a significant move or @ref GPS_PERSIST_INTERVAL_MS,
+ * which keeps flash wear negligible for a stationary node. The time of the
+ * fix tells how old the receiver's ephemeris was at the last save.
+ */
+struct gps_saved_fix {
+    int32_t lat;           /**< Latitude (µdeg). */
+    int32_t lon;           /**< Longitude (µdeg). */
+    int32_t alt;           /**< Altitude (cm). */
+    uint32_t time;         /**< Unix epoch of the fix (s). */
+};
+
+static struct gps_saved_fix saved;  /**< Last known good fix (guarded by @ref saved_lock). */
+static bool saved_valid;            /**< Whether @ref saved holds a fix. */
+static int64_t saved_uptime = -1;   /**< Uptime of the last save (ms), -1 before the first one. */
+static K_MUTEX_DEFINE(saved_lock);  /**< Guards @ref saved between the GPS and main threads. */
+
+/**
+ * @brief Settings handler: loads the last known good fix.
+ */
+static int gps_settings_set(const char *name, size_t len,
+                            settings_read_cb read_cb, void *cb_arg)
+{
+    const char *next;
+
+    if (settings_name_steq(name, "fix", &next) && !next) {
+        if (len != sizeof(saved)) return -EINVAL;
+
+        int ret = read_cb(cb_arg, &saved, sizeof(saved));
+        if (ret < 0) return ret;
+
+        saved_valid = true;
+        return 0;
+    }
+
+    return -ENOENT;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(gps, "gps", NULL, gps_settings_set, NULL, NULL);
+
 /* ---------------------------------------------------------------------------
  * Helper functions
  * ---------------------------------------------------------------------------*/
 
 /**
- * @brief Read GPS data and update shared measurements.
+ * @brief Wait until the receiver publishes a fix with a valid position.
  *
- * This function waits for a valid NMEA GGA sentence, parses its fields,
- * and updates the shared @ref system_measurement structure with scaled
- * integer values for safe atomic storage.
+ * The first valid fix after a wake-up records the time-to-fix.
+ *
+ * @param data Pointer to a persistent @ref gps_data_t buffer (last epoch on return).
+ * @param timeout_ms Maximum wait time (ms).
+ * @retval 0 If a valid fix was received.
+ * @retval -EAGAIN If no epoch at all was received.
+ * @retval -ETIMEDOUT If epochs were received but none had a valid position.
+ */
+static int wait_valid_fix(gps_data_t *data, uint32_t timeout_ms)
+{
+    int64_t deadline = k_uptime_get() + timeout_ms;
+    int ret = -EAGAIN;
+
+    do {
+        if (gps_wait_for_fix(data, K_MSEC(GPS_EPOCH_TIMEOUT_MS)) < 0) continue;
+
+        ret = -ETIMEDOUT;
+        if (data->fix_quality == 0) continue;
+
+        if (duty.awake && !duty.fixed) {
+            duty.fixed = true;
+            duty.fixes++;
+            duty.last_ttff_ms = (uint32_t)(k_uptime_get() - duty.wake_time);
+            duty.total_ttff_ms += duty.last_ttff_ms;
+        }
+        return 0;
+    } while (k_uptime_get() < deadline);
+
+    return ret;
+}
+
+/**
+ * @brief Inject the current time and the last known good position.
+ *
+ * Must only be called while the receiver is awake: any byte on the UART
+ * wakes it from standby behind the duty-cycle accounting.
+ */
+static void gps_aid(void)
+{
+    struct gps_utc now;
+    uint32_t epoch = timekeeping_now();
+    int ret;
+
+    timekeeping_epoch_to_utc(epoch, &now);
+
+    k_mutex_lock(&saved_lock, K_FOREVER);
+
+    if (saved_valid) {
+        struct gps_utc fix_utc;
+        timekeeping_epoch_to_utc(saved.time, &fix_utc);
+        printk("[GPS] - Warm start from %d, %d (fix of %04u-%02u-%02u %02u:%02u UTC)\n",
+               saved.lat, saved.lon, fix_utc.year, fix_utc.month, fix_utc.day,
+               fix_utc.hour, fix_utc.minute);
+        ret = gps_aid_position(saved.lat, saved.lon, saved.alt, &now);
+    } else {
+        ret = gps_aid_time(&now);
+    }
+
+    k_mutex_unlock(&saved_lock);
+
+    if (ret < 0) {
+        printk("[GPS] - Aiding rejected (%d)\n", ret);
+    }
+}
+
+/**
+ * @brief Take the receiver out of standby and start the time-to-fix clock.
+ *
+ * Pending warm-start aiding is sent right after the wake-up, so it speeds
+ * up the fix that follows.
+ */
+static void gps_power_up(void)
+{
+    if (duty.awake) return;
+
+    if (gps_wakeup() < 0) {
+        printk("[GPS] - Receiver did not acknowledge wake-up\n");
+    }
+
+    duty.awake = true;
+    duty.fixed = false;
+    duty.wakeups++;
+    duty.wake_time = k_uptime_get();
+
+    if (atomic_clear(&aid_pending)) {
+        gps_aid();
+    }
+}
+
+/**
+ * @brief Put the receiver into standby and account its on-time.
+ */
+static void gps_power_down(void)
+{
+    if (!duty.awake) return;
+
+    if (!duty.fixed) duty.fix_timeouts++;
+
+    if (gps_standby() < 0) {
+        printk("[GPS] - Receiver did not acknowledge standby, left running\n");
+        return;
+    }
+
+    duty.awake = false;
+    duty.on_time_ms += (uint64_t)(k_uptime_get() - duty.wake_time);
+}
+
+/**
+ * @brief Print the duty-cycle counters.
+ */
+static void print_duty_stats(void)
+{
+    int64_t uptime = k_uptime_get();
+    uint32_t on_pct = (uptime > 0) ? (uint32_t)((duty.on_time_ms * 100) / (uint64_t)uptime) : 0;
+    uint32_t mean_ttff = duty.fixes ? (uint32_t)(duty.total_ttff_ms / duty.fixes) : 0;
+
+    printk("[GPS] - TTFF: last %u ms, mean %u ms | wake-ups %u, no-fix %u, reused %u | on-time %u s (%u%%)\n",
+           duty.last_ttff_ms, mean_ttff, duty.wakeups, duty.fix_timeouts, duty.reused,
+           (uint32_t)(duty.on_time_ms / 1000), on_pct);
+}
+
+/**
+ * @brief Read the motion counter published by the motion monitor.
+ *
+ * @return Number of motion events since boot.
+ */
+static uint32_t motion_count(void)
+{
+    struct motion_event event = {0};
+
+    zbus_chan_read(&motion_chan, &event, CHANNEL_TIMEOUT);
+    return event.count;
+}
+
+/**
+ * @brief Check whether the cached fix can stand for a new one.
  *
- * @param data Pointer to a persistent @ref gps_data_t buffer.
- * @param measure Pointer to the shared measurement structure.
  * @param ctx Pointer to the shared system context.
+ * @param at Uptime (ms) at which the fix would be used.
+ * @retval true If the node has not moved since the fix and the fix will
+ *         still be younger than @ref system_context::gps_max_fix_age_ms.
+ * @retval false Otherwise.
  */
-static void read_gps_data(gps_data_t *data,
-                          struct system_measurement *measure,
-                          struct system_context *ctx) {
+static bool fix_reusable(struct system_context *ctx, int64_t at)
+{
+    return cache.valid &&
+           motion_count() == cache.motion &&
+           (at - cache.fix_time) < ctx->gps_max_fix_age_ms;
+}
 
-    if (gps_wait_for_gga(data, K_MSEC(1000)) == 0) {
-        
-        if (data->lat == 0.0f && data->lon == 0.0f && data->alt == 0.0f) {          
-            atomic_set(&measure->gps_lat, (int32_t)(35.709662f * 1e6f));
-            atomic_set(&measure->gps_lon, (int32_t)(139.810793f * 1e6f));
-            atomic_set(&measure->gps_alt, (int32_t)(100 * 100.0f));
-        } else {
-            atomic_set(&measure->gps_lat, (int32_t)(data->lat * 1e6f));
-            atomic_set(&measure->gps_lon, (int32_t)(data->lon * 1e6f));
-            atomic_set(&measure->gps_alt, (int32_t)(data->alt * 100.0f));
+/**
+ * @brief Merge a valid fix into the position filter.
+ *
+ * The filter is restarted first if the node moved since the previous fix.
+ * An epoch already merged (same sequence number) is ignored.
+ *
+ * @param data Pointer to a fix with a valid position.
+ */
+static void position_filter_add(const gps_data_t *data)
+{
+    uint32_t motion = motion_count();
+
+    if (filter.count > 0 && motion != filter.motion) {
+        printk("[GPS] - Node moved, position filter restarted\n");
+        memset(&filter, 0, sizeof(filter));
+    }
+    filter.motion = motion;
+
+    if (filter.count > 0 && data->seq == filter.last_seq) return;
+
+    uint32_t hdop = MAX(data->hdop, GPS_FILTER_MIN_HDOP);
+    int64_t weight = 1000000 / (hdop * hdop);   /* 1/HDOP², 400 at the floor */
+
+    if (filter.count >= GPS_FILTER_MAX_FIXES) {
+        filter.sum_lat /= 2;
+        filter.sum_lon /= 2;
+        filter.sum_alt /= 2;
+        filter.sum_weight /= 2;
+        filter.count /= 2;
+    }
+
+    filter.sum_lat += weight * data->lat;
+    filter.sum_lon += weight * data->lon;
+    filter.sum_alt += weight * data->alt;
+    filter.sum_weight += weight;
+    filter.count++;
+    filter.last_seq = data->seq;
+}
+
+/**
+ * @brief Persist the filtered position if it moved or the last save is old.
+ *
+ * Uses the filtered @ref position; nothing is saved until the clock is set.
+ */
+static void persist_fix(void)
+{
+    int32_t lat = position.lat;
+    int32_t lon = position.lon;
+    int64_t now = k_uptime_get();
+
+    if (position.time == TIMEKEEPING_EPOCH_UNKNOWN) return;
+
+    k_mutex_lock(&saved_lock, K_FOREVER);
+
+    bool moved = !saved_valid ||
+                 abs(lat - saved.lat) > GPS_PERSIST_MIN_UDEG ||
+                 abs(lon - saved.lon) > GPS_PERSIST_MIN_UDEG;
+    bool due = (saved_uptime < 0) || (now - saved_uptime >= GPS_PERSIST_INTERVAL_MS);
+
+    if (moved || due) {
+        saved.lat = lat;
+        saved.lon = lon;
+        saved.alt = position.alt;
+        saved.time = position.time;
+        saved_valid = true;
+        saved_uptime = now;
+
+        int ret = settings_save_one(GPS_SETTINGS_KEY, &saved, sizeof(saved));
+        if (ret < 0) {
+            printk("[GPS] - Failed to persist last fix (%d)\n", ret);
         }
+    }
+
+    k_mutex_unlock(&saved_lock);
+}
+
+/**
+ * @brief Read GPS data and publish the position.
+ *
+ * The newest fix is taken immediately when it is valid and no older than
+ * @ref GPS_FIX_MAX_AGE_MS. Otherwise this function waits (at most
+ * @ref GPS_FIX_TIMEOUT_MS) for a fused GPS fix with a valid position. The
+ * fix is merged into the position filter and the filtered position is
+ * published on @c gps_chan. The driver already provides fixed-point values (microdegrees,
+ * centimetres), which are stored as-is. A valid RMC date and time
+ * disciplines the wall clock, and the fix is stamped with its Unix epoch.
+ *
+ * @param data Pointer to a persistent @ref gps_data_t buffer.
+ */
+static void read_gps_data(gps_data_t *data) {
+
+    int ret = gps_get_latest(data, GPS_FIX_MAX_AGE_MS);
+
+    if (ret < 0 || data->fix_quality == 0) {
+        ret = wait_valid_fix(data, GPS_FIX_TIMEOUT_MS);
+    }
 
-        atomic_set(&measure->gps_sats, (int32_t)data->sats);
-        
-        /* Parse UTC time in HHMMSS format */
-        if (strlen(data->utc_time) >= 6) {
-            int hh = (data->utc_time[0] - '0') * 10 + (data->utc_time[1] - '0') + 1;
-            int mm = (data->utc_time[2] - '0') * 10 + (data->utc_time[3] - '0');
-            int ss = (data->utc_time[4] - '0') * 10 + (data->utc_time[5] - '0');
+    if (ret != -EAGAIN) {
 
-            int time_int = hh * 10000 + mm * 100 + ss; /**< Encoded time as HHMMSS integer. */
-            atomic_set(&measure->gps_time, time_int);
+        if (data->fix_quality == 0) {
+            /* No fix: keep reporting the last known good position */
+            k_mutex_lock(&saved_lock, K_FOREVER);
+            if (saved_valid) {
+                position.lat = saved.lat;
+                position.lon = saved.lon;
+                position.alt = saved.alt;
+                position.time = saved.time;
+            }
+            k_mutex_unlock(&saved_lock);
         } else {
-            atomic_set(&measure->gps_time, -1); /**< Invalid or missing time. */
+            position_filter_add(data);
+            cache.valid = true;
+            cache.fix_time = k_uptime_get();
+            cache.motion = filter.motion;
+            position.lat = (int32_t)(filter.sum_lat / filter.sum_weight);
+            position.lon = (int32_t)(filter.sum_lon / filter.sum_weight);
+            position.alt = (int32_t)(filter.sum_alt / filter.sum_weight);
+
+            if (data->valid && (data->sentences & GPS_SENTENCE_RMC)) {
+                timekeeping_sync_utc(&data->utc, data->uptime, TIMEKEEPING_SOURCE_GPS);
+            }
+            position.time = timekeeping_epoch_at(data->uptime);
+            persist_fix();
         }
 
+        position.sats = (uint8_t)data->sats;
+        zbus_chan_pub(&gps_chan, &position, CHANNEL_TIMEOUT);
+
     } else {
         printk("[GPS] - Timeout: No data received from UART\n");
     }
@@ -81,24 +453,57 @@ static void read_gps_data(gps_data_t *data,
 /**
  * @brief GPS measurement thread entry function.
  *
- * Continuously monitors the system mode and performs GPS readings
- * according to the configured update rate. Synchronizes with the
- * main thread via semaphores.
+ * Produces one position every @ref system_context::report_period_ms. While
+ * the motion monitor reports no motion, the cached fix stands for a new
+ * one without waking the receiver, until the fix reaches
+ * @ref system_context::gps_max_fix_age_ms. Otherwise, after each reading the
+ * receiver is put into standby and the thread sleeps until
+ * @ref GPS_WAKE_LEAD_MS before the next scheduled fix. It then wakes the
+ * receiver and merges the fixes it produces into the position filter
+ * until that time, so the next position is fresh and averaged while the
+ * receiver stays in standby most of the period.
  *
  * @param arg1 Pointer to the shared @ref system_context structure.
- * @param arg2 Pointer to the shared @ref system_measurement structure.
+ * @param arg2 Unused (set to NULL).
  * @param arg3 Unused (set to NULL).
  */
 static void gps_thread_fn(void *arg1, void *arg2, void *arg3) {
     struct system_context *ctx = (struct system_context *)arg1;
-    struct system_measurement *measure = (struct system_measurement *)arg2;
 
     gps_data_t gps_data = {0};
+    int64_t next = k_uptime_get();
+
+    /* The receiver runs from boot */
+    duty.awake = true;
+    duty.wake_time = k_uptime_get();
 
     while (1) {
-        k_sem_take(ctx->gps_sem, K_FOREVER);
-        read_gps_data(&gps_data, measure, ctx);
-        k_sem_give(ctx->main_gps_sem);
+        k_sleep(K_TIMEOUT_ABS_MS(next));
+
+        if (fix_reusable(ctx, next)) {
+            /* Not moved: the last published position still holds */
+            duty.reused++;
+        } else {
+            gps_power_up(); /* No-op when woken up ahead of this fix */
+            read_gps_data(&gps_data);
+        }
+
+        gps_power_down();
+        print_duty_stats();
+
+        /* Stay in standby if the next fix can still be taken from the cache */
+        next += ctx->report_period_ms;
+        if (fix_reusable(ctx, next)) continue;
+
+        k_sleep(K_TIMEOUT_ABS_MS(next - GPS_WAKE_LEAD_MS));
+        gps_power_up();
+
+        /* Average the fixes produced until the scheduled time; the receiver is on anyway */
+        while (k_uptime_get() < next) {
+            if (wait_valid_fix(&gps_data, GPS_EPOCH_TIMEOUT_MS) == 0) {
+                position_filter_add(&gps_data);
+            }
+        }
     }
 }
 
@@ -106,22 +511,47 @@ static void gps_thread_fn(void *arg1, void *arg2, void *arg3) {
  * Thread Startup
  * ---------------------------------------------------------------------------*/
 
+/**
+ * @brief Request the warm-start aiding of the receiver.
+ *
+ * @retval 0 If the aiding will be sent at the next receiver wake-up.
+ * @retval -EAGAIN If the wall clock is not set.
+ */
+int gps_thread_warm_start(void)
+{
+    if (timekeeping_now() == TIMEKEEPING_EPOCH_UNKNOWN) return -EAGAIN;
+
+    atomic_set(&aid_pending, 1);
+    return 0;
+}
+
 /**
  * @brief Start the GPS measurement thread.
  *
- * Initializes the GPS timer, semaphores, and creates the GPS thread
- * that continuously manages GPS data acquisition and synchronization
- * with the main thread.
+ * Loads the last known good fix from the settings storage (publishing it
+ * as the initial position), then creates the GPS thread that continuously
+ * manages GPS data acquisition.
  *
  * @param ctx Pointer to the shared @ref system_context structure.
- * @param measure Pointer to the shared @ref system_measurement structure.
  */
-void start_gps_thread(struct system_context *ctx, struct system_measurement *measure) {
+void start_gps_thread(struct system_context *ctx) {
+    if (settings_subsys_init() == 0) {
+        settings_load_subtree("gps");
+    }
+
+    if (saved_valid) {
+        position.lat = saved.lat;
+        position.lon = saved.lon;
+        position.alt = saved.alt;
+        position.time = saved.time;
+        zbus_chan_pub(&gps_chan, &position, CHANNEL_TIMEOUT);
+    }
+
     k_thread_create(&gps_thread_data,
                     gps_stack,
                     K_THREAD_STACK_SIZEOF(gps_stack),
                     gps_thread_fn,
-                    ctx, measure, NULL,
+                    ctx, NULL, NULL,
                     GPS_THREAD_PRIORITY, 0, K_NO_WAIT);
 
     k_thread_name_set(&gps_thread_data, "gps_thread");
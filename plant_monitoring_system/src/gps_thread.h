@@ -15,18 +15,31 @@
 /**
  * @brief Start the GPS measurement thread.
  *
- * Initializes synchronization primitives (timer and semaphores) and creates
- * a dedicated Zephyr thread that periodically reads and parses GPS data from
- * the configured GPS module.
+ * Creates a dedicated Zephyr thread that periodically reads and parses GPS
+ * data from the configured GPS module.
  *
- * The thread stores scaled integer values in @ref system_measurement:
+ * The thread publishes @ref gps_sample messages on @c gps_chan with scaled
+ * integer values:
  *  - Latitude / Longitude: degrees × 1e6
  *  - Altitude: meters × 100
- *  - Time (UTC): integer in HHMMSS format
+ *  - Time: Unix epoch of the fix in seconds (0 while the clock is not set)
  *
- * @param ctx Pointer to a valid @ref system_context structure with configuration and semaphores.
- * @param measure Pointer to a valid @ref system_measurement structure to store GPS readings.
+ * @param ctx Pointer to a valid @ref system_context structure with the GPS configuration.
  */
-void start_gps_thread(struct system_context *ctx, struct system_measurement *measure);
+void start_gps_thread(struct system_context *ctx);
+
+/**
+ * @brief Warm-start the GPS receiver after a reboot.
+ *
+ * Requests the injection of the current UTC time and, if one was persisted,
+ * the last known good position (PMTK741), so the next fix does not need a
+ * cold start. The GPS thread sends the aiding the next time it wakes the
+ * receiver, so the receiver is never woken up behind its duty cycle.
+ * Call it once the wall clock is set (e.g. from the network time).
+ *
+ * @retval 0 If the aiding was scheduled.
+ * @retval -EAGAIN If the wall clock is not set.
+ */
+int gps_thread_warm_start(void);
 
 #endif /* GPS_THREAD_H */
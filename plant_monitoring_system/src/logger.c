@@ -0,0 +1,66 @@
+/**
+ * @file logger.c
+ * @brief Measurement logger: prints every sample published on the bus.
+ *
+ * Unlike the listeners, which run in the publisher's context, the logger
+ * is a zbus subscriber with its own low-priority thread, so console output
+ * never delays sampling. If it falls behind, it prints the latest value of
+ * each notified channel.
+ */
+
+#include "channels.h"
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* --- Thread configuration --------------------------------------------------- */
+#define LOGGER_THREAD_STACK_SIZE 1024  /**< Stack size allocated for the logger thread. */
+#define LOGGER_THREAD_PRIORITY   10    /**< Below the producers (lower = higher priority). */
+#define LOGGER_QUEUE_SIZE        8     /**< Pending channel notifications. */
+
+ZBUS_SUBSCRIBER_DEFINE(logger_sub, LOGGER_QUEUE_SIZE);
+ZBUS_CHAN_ADD_OBS(env_chan, logger_sub, 3);
+ZBUS_CHAN_ADD_OBS(accel_chan, logger_sub, 3);
+ZBUS_CHAN_ADD_OBS(gps_chan, logger_sub, 3);
+ZBUS_CHAN_ADD_OBS(motion_chan, logger_sub, 3);
+ZBUS_CHAN_ADD_OBS(alarm_chan, logger_sub, 3);
+
+/**
+ * @brief Logger thread entry function.
+ *
+ * Waits for channel notifications and prints the current message of the
+ * notified channel.
+ */
+static void logger_thread_fn(void *arg1, void *arg2, void *arg3)
+{
+    const struct zbus_channel *chan;
+
+    while (zbus_sub_wait(&logger_sub, &chan, K_FOREVER) == 0) {
+        if (chan == &env_chan) {
+            struct env_sample env;
+            zbus_chan_read(chan, &env, CHANNEL_TIMEOUT);
+            printk("[LOG] - %u ENV light %d (%d-%d) moisture %d (%d-%d) temp %d hum %d rgbc %u/%u/%u/%u\n",
+                   env.timestamp, env.brightness, env.brightness_min, env.brightness_max,
+                   env.moisture, env.moisture_min, env.moisture_max, env.temp, env.hum,
+                   env.red, env.green, env.blue, env.clear);
+        } else if (chan == &accel_chan) {
+            struct accel_sample accel;
+            zbus_chan_read(chan, &accel, CHANNEL_TIMEOUT);
+            printk("[LOG] - %u ACCEL %d %d %d\n", accel.timestamp, accel.x, accel.y, accel.z);
+        } else if (chan == &gps_chan) {
+            struct gps_sample gps;
+            zbus_chan_read(chan, &gps, CHANNEL_TIMEOUT);
+            printk("[LOG] - %u GPS %d %d %d sats %u\n", gps.time, gps.lat, gps.lon, gps.alt, gps.sats);
+        } else if (chan == &motion_chan) {
+            struct motion_event motion;
+            zbus_chan_read(chan, &motion, CHANNEL_TIMEOUT);
+            printk("[LOG] - %u MOTION count %u\n", motion.timestamp, motion.count);
+        } else if (chan == &alarm_chan) {
+            struct alarm_event alarm;
+            zbus_chan_read(chan, &alarm, CHANNEL_TIMEOUT);
+            printk("[LOG] - %u ALARM 0x%02x\n", alarm.timestamp, alarm.type);
+        }
+    }
+}
+
+K_THREAD_DEFINE(logger_thread, LOGGER_THREAD_STACK_SIZE, logger_thread_fn,
+                NULL, NULL, NULL, LOGGER_THREAD_PRIORITY, 0, 0);
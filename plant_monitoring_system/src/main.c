@@ -13,27 +13,57 @@
 #include <zephyr/device.h>
 #include <zephyr/lorawan/lorawan.h>
 #include <math.h>
+#include <stddef.h>
+#include <stdlib.h>
 
 #include "main.h"
 #include "sensors_thread.h"
 #include "gps_thread.h"
+#include "timekeeping.h"
+#include "measurement.h"
+#include "accel_stream.h"
 
 /* --- Sensors Configuration -------------------------------------------------------- */
 #define ACCEL_RANGE ACCEL_2G      /**< Accelerometer full-scale range setting. */
+#define ACCEL_ODR   ACCEL_ODR_12_5HZ /**< Accelerometer FIFO data rate. */
+#define ACCEL_FIFO_WATERMARK 25   /**< Samples per accelerometer block (2 s at 12.5 Hz). */
+#define ACCEL_FREEFALL_MG    190  /**< Freefall: every axis below this acceleration (mg)... */
+#define ACCEL_FREEFALL_COUNT 2    /**< ...for this many samples (160 ms at 12.5 Hz). */
+#define ACCEL_SHOCK_MG       500  /**< Shock: high-pass filtered change above this acceleration (mg). */
+#define ACCEL_SHOCK_COUNT    0    /**< Shock debounce (samples): report the first one. */
 
 #define COLOR_GAIN GAIN_4X        /**< Color sensor gain setting. */
 #define COLOR_INTEGRATION_TIME INTEGRATION_154MS /**< Color sensor integration time in ms. */ 
 
 #define TEMP_HUM_RESOLUTION TH_RES_RH12_TEMP14  /**< Temp/Hum sensor resolution setting. */
 
+#define ADC_OVERSAMPLING 4        /**< ADC hardware oversampling: 2^4 = 16 conversions averaged. */
+#define ADC_STREAM_INTERVAL_US 10000 /**< Continuous-mode sampling interval (100 Hz, one block every 320 ms). */
+#define SOIL_POWER_SETTLE_MS 20   /**< Soil moisture probe output settling after power-on. */
+
+#define GPS_BAUDRATE        115200  /**< GPS link baud rate after configuration (boots at the overlay's 9600). */
+#define GPS_FIX_INTERVAL_MS 1000    /**< GPS position fix interval. */
+#define GPS_MAX_FIX_AGE_MS  (60 * 60 * 1000) /**< GPS fix reused without a new acquisition while the node does not move. */
+
+#define GPS_ABSOLUTE_EVERY  10      /**< Uplinks between absolute position reports (new delta reference). */
+#define GPS_NO_CHANGE_UDEG  10      /**< Latitude/longitude change (µdeg, ~1 m) reported as "no change". */
+#define GPS_NO_CHANGE_CM    200     /**< Altitude change (cm) reported as "no change". */
+
 /* --- LoRaWAN Configuration -------------------------------------------------------- */
 #define LORAWAN_DEV_EUI     { 0x7a, 0x39, 0x32, 0x35, 0x59, 0x37, 0x91, 0x94 } /**< Device EUI (unique device identifier). */
 #define LORAWAN_JOIN_EUI    { 0x70, 0xB3, 0xD5, 0x7E, 0xD0, 0x00, 0xFC, 0x4D } /**< Join EUI (application identifier). */
 #define LORAWAN_APP_KEY     { 0xf3, 0x1c, 0x2e, 0x8b, 0xc6, 0x71, 0x28, 0x1d, 0x51, 0x16, 0xf0, 0x8f, 0xf0, 0xb7, 0x92, 0x8f } /**< Application Key (for OTAA join). */
 
-#define DELAY               K_MSEC(60000) /**< Data transmission interval (60s). */
+#define REPORT_PERIOD_MS    60000         /**< Data transmission interval in milliseconds. */
+#define SENSORS_PERIOD_MS   REPORT_PERIOD_MS /**< Environment sample publication interval in milliseconds. */
 #define JOIN_RETRY_DELAY    K_SECONDS(30) /**< Delay between network join attempts. */
 #define NUM_MAX_RETRIES     30            /**< Maximum number of join retries. */
+#define REPORT_PORT         1             /**< LoRaWAN port of the periodic measurement uplinks. */
+#define ALARM_PORT          2             /**< LoRaWAN port of the alarm uplinks. */
+#define ALARM_HOLDOFF_MS    30000         /**< Minimum interval between alarm uplinks; later alarms are merged. */
+#define DEVICE_TIME_RETRIES 5             /**< Polls for the DeviceTimeAns after the request. */
+#define GPS_UNIX_OFFSET     315964800     /**< GPS epoch (1980-01-06) as a Unix timestamp. */
+#define GPS_UTC_LEAP_SECONDS 18           /**< GPS-UTC offset in seconds (since 2017). */
 
 #define LOG_LEVEL CONFIG_LOG_DEFAULT_LEVEL
 LOG_MODULE_REGISTER(plant_monitor_main);
@@ -50,6 +80,18 @@ static struct adc_config pt = {
     .ref = ADC_REF_INTERNAL,
     .acquisition_time = ADC_ACQ_TIME_DEFAULT,
     .vref_mv = 3300,
+    .oversampling = ADC_OVERSAMPLING,
+};
+
+/**
+ * @brief Soil moisture probe supply, switched on only around its conversions.
+ *
+ * Declared as @c soil-power-gpios in the @c zephyr,user node; without it
+ * the probe is considered always powered.
+ */
+static struct adc_power soil_power = {
+    .gpio = GPIO_DT_SPEC_GET_OR(DT_PATH(zephyr_user), soil_power_gpios, {0}),
+    .settle_ms = SOIL_POWER_SETTLE_MS,
 };
 
 /**
@@ -63,6 +105,20 @@ static struct adc_config sm = {
     .ref = ADC_REF_INTERNAL,
     .acquisition_time = ADC_ACQ_TIME_DEFAULT,
     .vref_mv = 3300,
+    .oversampling = ADC_OVERSAMPLING,
+    .power = &soil_power,
+};
+
+/**
+ * @brief Continuous sampling of the light channel (CONFIG_ADC_ASYNC).
+ *
+ * The soil moisture probe is left to the scheduler, which powers it only
+ * around its conversions.
+ */
+static struct adc_stream adc_stream = {
+    .cfgs = { &pt },
+    .count = 1,
+    .interval_us = ADC_STREAM_INTERVAL_US,
 };
 
 /**
@@ -73,6 +129,21 @@ static struct i2c_dt_spec accel = {
     .addr = ACCEL_I2C_ADDR,
 };
 
+/**
+ * @brief Accelerometer FIFO stream configuration (INT1 wired to the ff0 alias).
+ */
+static const struct accel_stream_config accel_stream = {
+    .dev = &accel,
+    .irq = GPIO_DT_SPEC_GET(DT_ALIAS(ff0), gpios),
+    .range = ACCEL_RANGE,
+    .odr = ACCEL_ODR,
+    .watermark = ACCEL_FIFO_WATERMARK,
+    .freefall_mg = ACCEL_FREEFALL_MG,
+    .freefall_count = ACCEL_FREEFALL_COUNT,
+    .shock_mg = ACCEL_SHOCK_MG,
+    .shock_count = ACCEL_SHOCK_COUNT,
+};
+
 /**
  * @brief Temperature and humidity sensor I2C configuration.
  */
@@ -89,11 +160,22 @@ static struct i2c_dt_spec color = {
     .addr = COLOR_I2C_ADDR,
 };
 
+#ifdef CONFIG_I2C_RTIO
+/* RTIO I/O devices of the I2C sensors, matched to the specs above by bus and address */
+I2C_IODEV_DEFINE(accel_iodev, DT_NODELABEL(i2c2), ACCEL_I2C_ADDR);
+I2C_IODEV_DEFINE(th_iodev, DT_NODELABEL(i2c2), TH_I2C_ADDR);
+I2C_IODEV_DEFINE(color_iodev, DT_NODELABEL(i2c2), COLOR_I2C_ADDR);
+#endif
+
 /**
  * @brief GPS UART configuration.
  */
 static struct gps_config gps = {
     .dev = DEVICE_DT_GET(DT_NODELABEL(usart1)),
+    .rx_mode = GPS_RX_MODE_ASYNC,
+    .baudrate = GPS_BAUDRATE,
+    .fix_interval_ms = GPS_FIX_INTERVAL_MS,
+    .sentences = GPS_SENTENCE_ALL,
 };
 
 /**
@@ -108,18 +190,12 @@ static struct bus_rgb_led rgb_leds = {
     .pin_count = BUS_SIZE,
 };
 
-/* --- Semaphores ----------------------------------------------------------- */
-static K_SEM_DEFINE(main_sensors_sem, 0, 1); /**< Signal from sensors thread to main. */
-static K_SEM_DEFINE(main_gps_sem, 0, 1);     /**< Signal from GPS thread to main. */
-static K_SEM_DEFINE(sensors_sem, 0, 1);      /**< Trigger for sensors thread. */
-static K_SEM_DEFINE(gps_sem, 0, 1);          /**< Trigger for GPS thread. */
-
 /* --- Data ----------------------------------------------------------------- */
 /**
  * @brief Shared system context.
  *
- * Holds references to peripheral configurations and semaphores used
- * for inter-thread coordination.
+ * Holds references to peripheral configurations and the sampling
+ * periods of the producer threads.
  */
 static struct system_context ctx = {
     .phototransistor = &pt,
@@ -129,43 +205,35 @@ static struct system_context ctx = {
     .temp_hum = &th,
     .color = &color,
     .gps = &gps,
-    .main_sensors_sem = &main_sensors_sem,
-    .main_gps_sem = &main_gps_sem,
-    .sensors_sem = &sensors_sem,
-    .gps_sem = &gps_sem,
+    .report_period_ms = REPORT_PERIOD_MS,
+    .sensors_period_ms = SENSORS_PERIOD_MS,
+    .sensors = {
+        /* Fast-changing signals are sampled often (light is averaged), slow ones
+         * rarely; a common phase lets conversions due together overlap, and the
+         * accelerometer burst is collected last so the ADC is read meanwhile */
+        [SENSOR_LIGHT]    = { .period_ms = 10000,  .phase_ms = 0, .priority = 0 },
+        [SENSOR_MOISTURE] = { .period_ms = 600000, .phase_ms = 0, .priority = 1 },
+        [SENSOR_TEMP_HUM] = { .period_ms = 60000,  .phase_ms = 0, .priority = 2 },
+        [SENSOR_COLOR]    = { .period_ms = 60000,  .phase_ms = 0, .priority = 3 },
+        [SENSOR_ACCEL]    = { .period_ms = 5000,   .phase_ms = 0, .priority = 4 },
+    },
+    .gps_max_fix_age_ms = GPS_MAX_FIX_AGE_MS,
 };
 
-/**
- * @brief Shared measurements container (atomic storage).
- */
-static struct system_measurement measure = {
-    .brightness = ATOMIC_INIT(0),
-    .moisture = ATOMIC_INIT(0),
-    .accel_x = ATOMIC_INIT(0),
-    .accel_y = ATOMIC_INIT(0),
-    .accel_z = ATOMIC_INIT(0),
-    .temp = ATOMIC_INIT(0),
-    .hum = ATOMIC_INIT(0),
-    .red = ATOMIC_INIT(0),
-    .green = ATOMIC_INIT(0),
-    .blue = ATOMIC_INIT(0),
-    .clear = ATOMIC_INIT(0),
-    .gps_lat = ATOMIC_INIT(0),
-    .gps_lon = ATOMIC_INIT(0),
-    .gps_alt = ATOMIC_INIT(0),
-    .gps_sats = ATOMIC_INIT(0),
-    .gps_time = ATOMIC_INIT(0),
-};
+static struct measurement_data snapshot; /**< Coherent copy of the latest samples taken for each uplink. */
+
+/* GPS position block layouts (see main_measurement::gps_mode) */
+#define GPS_REPORT_ABSOLUTE  0  /**< 12 bytes: int32 lat, lon (µdeg), alt (cm). */
+#define GPS_REPORT_DELTA     1  /**< 6 bytes: int16 lat, lon (µdeg), alt (cm) change since the last absolute report. */
+#define GPS_REPORT_NO_CHANGE 2  /**< 0 bytes: position unchanged since the last absolute report. */
 
 /**
  * @brief LoRaWAN Uplink payload structure.
  */
 struct __attribute__((packed)) main_measurement {
-    // GPS Data (17 bytes)
-    int32_t  lat;       // 4 bytes (Scaled by 1e6)
-    int32_t  lon;       // 4 bytes (Scaled by 1e6)
-    int32_t  alt;       // 4 bytes (Value * 100 in meters)
-    uint8_t  time[3];   // 3 bytes (HH, MM, SS)
+    // Header (6 bytes)
+    uint8_t  gps_mode;  // 1 byte  (GPS_REPORT_*: layout of the trailing position block)
+    uint32_t time;      // 4 bytes (Unix epoch of the sample, 0 if unknown)
     uint8_t  sats;      // 1 byte  (Satellites in view)
 
     // Temperature and Humidity (4 bytes)
@@ -185,9 +253,61 @@ struct __attribute__((packed)) main_measurement {
     int8_t   x_axis;    // 1 byte
     int8_t   y_axis;    // 1 byte 
     int8_t   z_axis;    // 1 byte
+
+    // GPS Position (12, 6 or 0 bytes, only the used part is sent)
+    union __attribute__((packed)) {
+        struct __attribute__((packed)) {
+            int32_t lat;    // 4 bytes (Scaled by 1e6)
+            int32_t lon;    // 4 bytes (Scaled by 1e6)
+            int32_t alt;    // 4 bytes (Value * 100 in meters)
+        } abs;
+        struct __attribute__((packed)) {
+            int16_t lat;    // 2 bytes (Change scaled by 1e6)
+            int16_t lon;    // 2 bytes (Change scaled by 1e6)
+            int16_t alt;    // 2 bytes (Change * 100 in meters)
+        } delta;
+    } pos;
 };
 
 static struct main_measurement main_data;
+static size_t main_data_len; /**< Bytes of main_data actually sent. */
+
+#define ALARM_PAYLOAD_MARKER 0x80 /**< Set in the first byte of alarm uplinks (never a gps_mode value). */
+
+/**
+ * @brief LoRaWAN alarm payload, sent as soon as the accelerometer detects an event.
+ */
+struct __attribute__((packed)) alarm_measurement {
+    uint8_t  type;      // 1 byte  (ALARM_PAYLOAD_MARKER | ALARM_* flags)
+    uint32_t time;      // 4 bytes (Unix epoch of the latest merged event, 0 if unknown)
+};
+
+ZBUS_SUBSCRIBER_DEFINE(alarm_sub, 4);
+ZBUS_CHAN_ADD_OBS(alarm_chan, alarm_sub, 0);
+
+/**
+ * @brief Alarms waiting to be sent.
+ */
+static struct {
+    uint8_t type;             /**< ALARM_* flags merged since the last successful alarm uplink. */
+    uint32_t time;            /**< Epoch of the latest merged event. */
+    int64_t holdoff_end;      /**< Uptime before which no alarm uplink is sent (ms). */
+} alarm_pending;
+
+/**
+ * @brief Position of the last absolute report.
+ *
+ * Delta and "no change" reports are relative to it and leave it unchanged,
+ * so each of them decodes on its own once the server has the last absolute
+ * report: a lost unconfirmed uplink does not shift the following ones.
+ */
+static struct {
+    int32_t lat;              /**< Latitude (µdeg). */
+    int32_t lon;              /**< Longitude (µdeg). */
+    int32_t alt;              /**< Altitude (cm). */
+    uint16_t since_absolute;  /**< Uplinks since the last absolute report. */
+    bool valid;               /**< Whether an absolute report was sent. */
+} gps_reported;
 
 /* --- LoRaWAN Callbacks and Helpers ---------------------------------------- */
 
@@ -286,45 +406,127 @@ static int join_lorawan(void)
     return 0;
 }
 
+/**
+ * @brief Sets the clock from the network time and warm-starts the GPS receiver.
+ *
+ * Requests the current time with a LoRaWAN DeviceTimeReq, sets the wall
+ * clock with it (until the first GPS fix refines it) and has the GPS thread
+ * inject it, together with the persisted last known position, into the
+ * receiver at its next wake-up.
+ * Only done at boot: a failure just leaves the receiver in a cold start.
+ */
+static void gps_warm_start(void)
+{
+    uint32_t gps_seconds;
+    int ret = lorawan_request_device_time(true);
+
+    for (int i = 0; ret == 0 && i < DEVICE_TIME_RETRIES; i++) {
+        ret = lorawan_device_time_get(&gps_seconds);
+        if (ret == 0) break;
+        k_sleep(K_SECONDS(1));
+    }
+    if (ret < 0) {
+        LOG_WRN("Network time unavailable (%d), GPS cold start.", ret);
+        return;
+    }
+
+    int64_t unix_ms = ((int64_t)gps_seconds + GPS_UNIX_OFFSET - GPS_UTC_LEAP_SECONDS) * 1000;
+    timekeeping_sync(unix_ms, k_uptime_get(), TIMEKEEPING_SOURCE_NETWORK);
+
+    gps_thread_warm_start();
+}
+
 /* --- Data Processing Helpers ---------------------------------------------- */
 
+/**
+ * @brief Encodes the GPS position as an absolute, delta or "no change" block.
+ *
+ * The position of a plant node only carries receiver jitter, so it is sent
+ * in full every @ref GPS_ABSOLUTE_EVERY uplinks or when the change does not
+ * fit in 16 bits, and as a small signed change from that absolute report or
+ * no data at all otherwise.
+ *
+ * @return Size of the position block in bytes.
+ */
+static size_t encode_position(void)
+{
+    int32_t lat = snapshot.gps.lat;
+    int32_t lon = snapshot.gps.lon;
+    int32_t alt = snapshot.gps.alt;
+
+    int32_t d_lat = lat - gps_reported.lat;
+    int32_t d_lon = lon - gps_reported.lon;
+    int32_t d_alt = alt - gps_reported.alt;
+
+    if (!gps_reported.valid || gps_reported.since_absolute + 1 >= GPS_ABSOLUTE_EVERY ||
+        d_lat < INT16_MIN || d_lat > INT16_MAX || d_lon < INT16_MIN || d_lon > INT16_MAX ||
+        d_alt < INT16_MIN || d_alt > INT16_MAX) {
+        main_data.gps_mode = GPS_REPORT_ABSOLUTE;
+        main_data.pos.abs.lat = lat;
+        main_data.pos.abs.lon = lon;
+        main_data.pos.abs.alt = alt;
+        gps_reported.lat = lat;
+        gps_reported.lon = lon;
+        gps_reported.alt = alt;
+        gps_reported.since_absolute = 0;
+        gps_reported.valid = true;
+        return sizeof(main_data.pos.abs);
+    }
+
+    gps_reported.since_absolute++;
+
+    if (abs(d_lat) <= GPS_NO_CHANGE_UDEG && abs(d_lon) <= GPS_NO_CHANGE_UDEG &&
+        abs(d_alt) <= GPS_NO_CHANGE_CM) {
+        main_data.gps_mode = GPS_REPORT_NO_CHANGE;
+        return 0;
+    }
+
+    main_data.gps_mode = GPS_REPORT_DELTA;
+    main_data.pos.delta.lat = (int16_t)d_lat;
+    main_data.pos.delta.lon = (int16_t)d_lon;
+    main_data.pos.delta.alt = (int16_t)d_alt;
+    return sizeof(main_data.pos.delta);
+}
+
 /**
  * @brief Formats raw sensor data into the transmission structure.
+ *
+ * All fields come from one coherent snapshot of the shared measurements.
  */
 static void get_measurements(void)
 {
+    const struct env_sample *env = &snapshot.env;
+    const struct accel_sample *accel = &snapshot.accel;
+
+    measurement_snapshot(&snapshot);
+
     // GPS Data
-    main_data.lat = (int32_t)atomic_get(&measure.gps_lat);
-    main_data.lon = (int32_t)atomic_get(&measure.gps_lon);
-    main_data.alt = (int32_t)atomic_get(&measure.gps_alt);
-    main_data.sats = (uint8_t)atomic_get(&measure.gps_sats);
-
-    // Time Decompression: HHMMSS -> [HH, MM, SS]
-    uint32_t full_time = (uint32_t)atomic_get(&measure.gps_time);
-    main_data.time[0] = (uint8_t)(full_time / 10000);
-    main_data.time[1] = (uint8_t)((full_time / 100) % 100);
-    main_data.time[2] = (uint8_t)(full_time % 100);
+    main_data_len = offsetof(struct main_measurement, pos) + encode_position();
+    main_data.sats = snapshot.gps.sats;
+
+    // Sample time
+    main_data.time = env->timestamp;
     
     // Temperature and Humidity
-    main_data.temp = (int16_t)atomic_get(&measure.temp);
-    main_data.hum = (uint16_t)atomic_get(&measure.hum);
+    main_data.temp = (int16_t)env->temp;
+    main_data.hum = (uint16_t)env->hum;
 
     // Soil and Light
-    main_data.light = (uint16_t)atomic_get(&measure.brightness);
-    main_data.moisture = (uint16_t)atomic_get(&measure.moisture);
+    main_data.light = (uint16_t)env->brightness;
+    main_data.moisture = (uint16_t)env->moisture;
 
     // Color Normalization (0-100%)
-    uint32_t clear = atomic_get(&measure.clear);
+    uint32_t clear = env->clear;
     if (clear > 0) {
-        main_data.r_norm = (uint8_t)((atomic_get(&measure.red)   * 100) / clear);
-        main_data.g_norm = (uint8_t)((atomic_get(&measure.green) * 100) / clear);
-        main_data.b_norm = (uint8_t)((atomic_get(&measure.blue)  * 100) / clear);
+        main_data.r_norm = (uint8_t)((env->red   * 100) / clear);
+        main_data.g_norm = (uint8_t)((env->green * 100) / clear);
+        main_data.b_norm = (uint8_t)((env->blue  * 100) / clear);
     }
 
     // Accelerometer data
-    main_data.x_axis = (int8_t)(atomic_get(&measure.accel_x) / 10);
-    main_data.y_axis = (int8_t)(atomic_get(&measure.accel_y) / 10);
-    main_data.z_axis = (int8_t)(atomic_get(&measure.accel_z) / 10);
+    main_data.x_axis = (int8_t)(accel->x / 10);
+    main_data.y_axis = (int8_t)(accel->y / 10);
+    main_data.z_axis = (int8_t)(accel->z / 10);
 }
 
 /**
@@ -332,53 +534,95 @@ static void get_measurements(void)
  */
 static void display_measurements(void)
 {
+    const struct env_sample *env = &snapshot.env;
+    const struct accel_sample *accel = &snapshot.accel;
+    struct gps_utc utc;
+
     printk("-------------- SENSOR REPORT --------------\n");
 
+    // 0. Sample time
+    timekeeping_epoch_to_utc(main_data.time, &utc);
+    printk("TIME:      LoRa: %u | Value: %04u-%02u-%02u %02u:%02u:%02u UTC\n",
+           main_data.time, utc.year, utc.month, utc.day, utc.hour, utc.minute, utc.second);
+
     // 1. Soil Moisture
-    printk("MOISTURE:  Raw: %ld | LoRa: %u | Value: %.1f%%\n",
-           atomic_get(&measure.moisture), main_data.moisture, (double)main_data.moisture / 10.0);
+    printk("MOISTURE:  Raw: %d | LoRa: %u | Value: %.1f%%\n",
+           env->moisture, main_data.moisture, (double)main_data.moisture / 10.0);
 
     // 2. Light
-    printk("LIGHT:     Raw: %ld | LoRa: %u | Value: %.1f%%\n",
-           atomic_get(&measure.brightness), main_data.light, (double)main_data.light / 10.0);
+    printk("LIGHT:     Raw: %d | LoRa: %u | Value: %.1f%%\n",
+           env->brightness, main_data.light, (double)main_data.light / 10.0);
 
     // 3. Temperature & Humidity
-    printk("TEMP:      Raw: %ld | LoRa: %d | Value: %.2f C\n",
-           atomic_get(&measure.temp), main_data.temp, (double)main_data.temp / 100.0);
-    printk("HUMIDITY:  Raw: %ld | LoRa: %u | Value: %.2f%%\n",
-           atomic_get(&measure.hum), main_data.hum, (double)main_data.hum / 100.0);
-
-    // 4. GPS Location
-    printk("LATITUDE:  Raw: %ld | LoRa: %d | Value: %.6f\n",
-           atomic_get(&measure.gps_lat), main_data.lat, (double)main_data.lat / 1e6);
-    printk("LONGITUDE: Raw: %ld | LoRa: %d | Value: %.6f\n",
-           atomic_get(&measure.gps_lon), main_data.lon, (double)main_data.lon / 1e6);
-    printk("ALTITUDE:  Raw: %ld | LoRa: %d | Value: %.2f m\n",
-           atomic_get(&measure.gps_alt), main_data.alt, (double)main_data.alt / 100.0);
+    printk("TEMP:      Raw: %d | LoRa: %d | Value: %.2f C\n",
+           env->temp, main_data.temp, (double)main_data.temp / 100.0);
+    printk("HUMIDITY:  Raw: %d | LoRa: %u | Value: %.2f%%\n",
+           env->hum, main_data.hum, (double)main_data.hum / 100.0);
+
+    // 4. GPS Location (value decoded by the server)
+    static const char *const gps_modes[] = { "ABSOLUTE", "DELTA", "NO CHANGE" };
+    int32_t lat = gps_reported.lat;
+    int32_t lon = gps_reported.lon;
+    int32_t alt = gps_reported.alt;
+    if (main_data.gps_mode == GPS_REPORT_DELTA) {
+        lat += main_data.pos.delta.lat;
+        lon += main_data.pos.delta.lon;
+        alt += main_data.pos.delta.alt;
+    }
+    printk("GPS MODE:  %s\n", gps_modes[main_data.gps_mode]);
+    printk("LATITUDE:  Raw: %d | Value: %.6f\n", snapshot.gps.lat, (double)lat / 1e6);
+    printk("LONGITUDE: Raw: %d | Value: %.6f\n", snapshot.gps.lon, (double)lon / 1e6);
+    printk("ALTITUDE:  Raw: %d | Value: %.2f m\n", snapshot.gps.alt, (double)alt / 100.0);
 
     // 5. GPS Sats & Time
-    printk("GPS SATS:  Raw: %ld | LoRa: %u | Value: %u satellites\n",
-           atomic_get(&measure.gps_sats), main_data.sats, main_data.sats);
+    printk("GPS SATS:  Raw: %u | LoRa: %u | Value: %u satellites\n",
+           snapshot.gps.sats, main_data.sats, main_data.sats);
     
-    printk("GPS TIME:  Raw: %ld | LoRa: [%02d,%02d,%02d] | Value: %02d:%02d:%02d\n",
-           atomic_get(&measure.gps_time), 
-           main_data.time[0], main_data.time[1], main_data.time[2],
-           main_data.time[0], main_data.time[1], main_data.time[2]);
+    uint32_t fix_time = snapshot.gps.time;
+    timekeeping_epoch_to_utc(fix_time, &utc);
+    printk("GPS TIME:  Raw: %u | Value: %04u-%02u-%02u %02u:%02u:%02u UTC\n",
+           fix_time, utc.year, utc.month, utc.day, utc.hour, utc.minute, utc.second);
 
     // 6. Color (Normalizado en LoRa y Value)
-    printk("COLOR:     Raw R:%ld G:%ld B:%ld | LoRa R:%u%% G:%u%% B:%u%%\n",
-           atomic_get(&measure.red), atomic_get(&measure.green), atomic_get(&measure.blue),
+    printk("COLOR:     Raw R:%u G:%u B:%u | LoRa R:%u%% G:%u%% B:%u%%\n",
+           env->red, env->green, env->blue,
            main_data.r_norm, main_data.g_norm, main_data.b_norm);
 
     // 7. Accelerometer
-    printk("ACCEL:     Raw X:%ld Y:%ld Z:%ld | LoRa: X: %d Y: %d Z: %d | Value X:%.1f Y:%.1f Z:%.1f m/s2\n",
-           atomic_get(&measure.accel_x), atomic_get(&measure.accel_y), atomic_get(&measure.accel_z),
+    printk("ACCEL:     Raw X:%d Y:%d Z:%d | LoRa: X: %d Y: %d Z: %d | Value X:%.1f Y:%.1f Z:%.1f m/s2\n",
+           accel->x, accel->y, accel->z,
            main_data.x_axis, main_data.y_axis, main_data.z_axis,
            (double)main_data.x_axis / 10.0, (double)main_data.y_axis / 10.0, (double)main_data.z_axis / 10.0);
 
     printk("------------------------------------------\n\n");
 }
 
+/**
+ * @brief Sends the pending alarms as one confirmed uplink.
+ *
+ * Alarms arriving during the hold-off are merged into the next uplink,
+ * so a burst of detections does not exhaust the duty cycle. On failure the
+ * alarms stay pending and are retried once the hold-off has elapsed again.
+ */
+static void send_alarm(void)
+{
+    struct alarm_measurement alarm_data = {
+        .type = ALARM_PAYLOAD_MARKER | alarm_pending.type,
+        .time = alarm_pending.time,
+    };
+
+    int ret = lorawan_send(ALARM_PORT, (uint8_t *)&alarm_data, sizeof(alarm_data),
+                           LORAWAN_MSG_CONFIRMED);
+    if (ret < 0) {
+        LOG_ERR("Alarm transmission failed: %d, retrying in %d s", ret, ALARM_HOLDOFF_MS / 1000);
+    } else {
+        LOG_INF("Alarm 0x%02x sent", alarm_pending.type);
+        alarm_pending.type = 0;
+    }
+
+    alarm_pending.holdoff_end = k_uptime_get() + ALARM_HOLDOFF_MS;
+}
+
 /* --- Main Application ----------------------------------------------------- */
 
 int main(void)
@@ -394,42 +638,90 @@ int main(void)
         return -1;
     }
 
+    /* GPS output trimming is an optimization: keep running with defaults if it fails */
+    if (gps_configure(&gps) < 0) {
+        LOG_WRN("GPS configuration failed, using receiver defaults.");
+    }
+
+    /* Orbit predictions are only uploaded when an EPO image is stored in flash */
+    int epo_ret = gps_epo_load();
+    if (epo_ret < 0 && epo_ret != -ENOTSUP && epo_ret != -ENODATA) {
+        LOG_WRN("GPS EPO upload failed (%d).", epo_ret);
+    }
+
     /* 2. LoRaWAN Stack Initialization */
     if (init_lorawan() < 0) {
         LOG_ERR("LoRaWAN stack initialization failed.");
         return -1;
     }
 
-    /* 3. Thread Launch */
-    start_sensors_thread(&ctx, &measure);
-    start_gps_thread(&ctx, &measure);
+    /* The FIFO stream replaces polling the accelerometer when its interrupt is wired */
+    int stream_ret = accel_stream_start(&accel_stream);
+    if (stream_ret == 0) {
+        ctx.sensors[SENSOR_ACCEL].period_ms = 0;
+    } else {
+        LOG_WRN("Accelerometer FIFO stream unavailable (%d), polling instead.", stream_ret);
+    }
+
+    /* Continuous ADC sampling replaces the light snapshots when enabled */
+    int adc_ret = adc_stream_start(&adc_stream);
+    if (adc_ret == 0) {
+        ctx.adc_stream = &adc_stream;
+        ctx.sensors[SENSOR_LIGHT].period_ms = 0;
+    } else if (adc_ret != -ENOTSUP) {
+        LOG_WRN("Continuous ADC sampling unavailable (%d), sampling snapshots instead.", adc_ret);
+    }
+
+    /* 3. Thread Launch (producers publish on their own schedule) */
+    start_sensors_thread(&ctx);
+    start_gps_thread(&ctx);
 
     /* 4. Join Network */
     if (join_lorawan() < 0) {
         return -1;
     }
+    gps_warm_start();
+
+    /* 5. Main Loop: LoRaWAN Transmission of the latest published samples and of alarms */
+    int64_t next_uplink = k_uptime_get();
 
-    /* 5. Main Loop: Sensor Sampling & LoRaWAN Transmission */
     while (1) {
-        /* Request new readings from threads */
-        k_sem_give(ctx.sensors_sem);
-        k_sem_give(ctx.gps_sem);
+        const struct zbus_channel *chan;
+        int64_t wake = next_uplink;
+
+        if (alarm_pending.type != 0) {
+            wake = MIN(wake, alarm_pending.holdoff_end);
+        }
 
-        /* Wait for thread completion */
-        k_sem_take(ctx.main_sensors_sem, K_FOREVER);
-        k_sem_take(ctx.main_gps_sem, K_FOREVER);
+        /* Alarms interrupt the wait and go out ahead of the periodic uplink */
+        if (zbus_sub_wait(&alarm_sub, &chan, K_TIMEOUT_ABS_MS(wake)) == 0) {
+            struct alarm_event alarm;
+
+            zbus_chan_read(&alarm_chan, &alarm, CHANNEL_TIMEOUT);
+            alarm_pending.type |= alarm.type;
+            alarm_pending.time = alarm.timestamp;
+        }
+
+        if (alarm_pending.type != 0 && k_uptime_get() >= alarm_pending.holdoff_end) {
+            send_alarm();
+            continue;
+        }
+        if (k_uptime_get() < next_uplink) {
+            continue;
+        }
+        next_uplink += REPORT_PERIOD_MS;
 
         get_measurements();
         
         /* Send uplink message */
-        int ret = lorawan_send(1, (uint8_t *)&main_data, sizeof(main_data), LORAWAN_MSG_UNCONFIRMED);
+        int ret = lorawan_send(REPORT_PORT, (uint8_t *)&main_data, main_data_len, LORAWAN_MSG_UNCONFIRMED);
         if (ret < 0) {
             LOG_ERR("LoRaWAN transmission failed: %d", ret);
+            gps_reported.valid = false; /* The server may lack the reference: resend the absolute position */
         } else {
-            LOG_INF("Data packet sent successfully (%d bytes)", sizeof(main_data));
+            LOG_INF("Data packet sent successfully (%d bytes)", (int)main_data_len);
         }
 
         display_measurements(); 
-        k_sleep(DELAY);
     }
 }
\ No newline at end of file
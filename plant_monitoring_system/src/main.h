@@ -4,8 +4,8 @@
  *
  * This header defines shared data structures and enumerations
  * used across the main application, sensors thread, and GPS thread.
- * It provides a unified context for system configuration and
- * sensor measurements.
+ * It provides a unified context for system configuration; measurements
+ * are exchanged as messages on the zbus channels of channels.h.
  */
 
 #ifndef MAIN_H
@@ -20,17 +20,43 @@
 #include "sensors/i2c/color.h"
 #include "sensors/gps/gps.h"
 #include "sensors/led/rgb_led.h"
+#include "channels.h"
+
+/**
+ * @brief Sensors sampled by the sensors thread scheduler.
+ */
+enum sensor_id {
+    SENSOR_LIGHT = 0,  /**< Phototransistor (ADC), averaged between publications. */
+    SENSOR_MOISTURE,   /**< Soil moisture probe (ADC). */
+    SENSOR_ACCEL,      /**< Accelerometer (I2C) polling, disabled while the FIFO stream runs. */
+    SENSOR_TEMP_HUM,   /**< Si7021 temperature and humidity (I2C). */
+    SENSOR_COLOR,      /**< TCS34725 color sensor (I2C). */
+    SENSOR_COUNT,      /**< Number of scheduled sensors. */
+};
+
+/**
+ * @brief Sampling schedule of one sensor.
+ *
+ * The sensor is sampled at uptime phase_ms + k × period_ms. When several
+ * sensors are due at the same time, the lowest priority value runs first.
+ */
+struct sensor_timing {
+    uint32_t period_ms;  /**< Sampling period (ms), 0 to disable the sensor. */
+    uint32_t phase_ms;   /**< Offset of the first sample from the thread start (ms). */
+    uint8_t priority;    /**< Order among sensors due at the same time (lower = first). */
+};
 
 /**
  * @struct system_context
  * @brief Shared system context between main, sensors, and GPS threads.
  *
- * This structure contains pointers to configuration objects, semaphores,
- * and shared state used to coordinate between the main, sensors, and GPS threads.
+ * This structure contains pointers to configuration objects and the
+ * sampling schedule shared by the main, sensors, and GPS threads.
  */
 struct system_context {
     struct adc_config *phototransistor; /**< Phototransistor ADC configuration. */
     struct adc_config *soil_moisture;   /**< Soil moisture ADC configuration. */
+    struct adc_stream *adc_stream;      /**< Continuous light/moisture sampling, NULL when the scheduler samples them. */
 
     struct i2c_dt_spec *accelerometer;  /**< Accelerometer I2C device specification. */
     uint8_t accel_range;                /**< Accelerometer full-scale range (e.g., 2G, 4G, 8G). */
@@ -38,41 +64,10 @@ struct system_context {
     struct i2c_dt_spec *temp_hum;       /**< Temperature and humidity sensor I2C specification. */
     struct i2c_dt_spec *color;          /**< Color sensor I2C device specification. */
     struct gps_config *gps;             /**< GPS module configuration. */
-
-    struct k_sem *main_sensors_sem;     /**< Semaphore for main-to-sensors synchronization. */
-    struct k_sem *main_gps_sem;         /**< Semaphore for main-to-GPS synchronization. */
-    struct k_sem *sensors_sem;          /**< Semaphore to trigger sensor measurement. */
-    struct k_sem *gps_sem;              /**< Semaphore to trigger GPS measurement. */
-};
-
-/**
- * @struct system_measurement
- * @brief Shared sensor data between main, sensors, and GPS threads.
- *
- * Contains the most recent measurements for all sensors, stored
- * in atomic variables for thread-safe access.
- */
-struct system_measurement {
-    atomic_t brightness;  /**< Latest ambient brightness (0–100%). */
-    atomic_t moisture;    /**< Latest soil moisture (0–100%). */
-
-    atomic_t accel_x;   /**< Latest X-axis acceleration. */
-    atomic_t accel_y;   /**< Latest Y-axis acceleration. */
-    atomic_t accel_z;   /**< Latest Z-axis acceleration. */
-
-    atomic_t temp;        /**< Latest temperature (°C). */
-    atomic_t hum;         /**< Latest relative humidity (%RH). */
-
-    atomic_t red;         /**< Latest red color value (raw). */
-    atomic_t green;       /**< Latest green color value (raw). */
-    atomic_t blue;        /**< Latest blue color value (raw). */
-    atomic_t clear;       /**< Latest clear color channel value (raw). */
-
-    atomic_t gps_lat;     /**< Latest GPS latitude (degrees). */
-    atomic_t gps_lon;     /**< Latest GPS longitude (degrees). */
-    atomic_t gps_alt;     /**< Latest GPS altitude (meters). */
-    atomic_t gps_sats;    /**< Latest number of satellites in view. */
-    atomic_t gps_time;    /**< Latest GPS timestamp (float or encoded). */
+    uint32_t report_period_ms;          /**< Interval between uplinks (ms), also the GPS fix period. */
+    uint32_t sensors_period_ms;         /**< Interval between environment sample publications (ms). */
+    struct sensor_timing sensors[SENSOR_COUNT]; /**< Per-sensor sampling schedule. */
+    uint32_t gps_max_fix_age_ms;        /**< Maximum age (ms) of a GPS fix reused while the node does not move. */
 };
 
 #endif /* MAIN_H */
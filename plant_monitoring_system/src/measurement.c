@@ -0,0 +1,83 @@
+/**
+ * @file measurement.c
+ * @brief Seqlock-protected store of the latest measurements.
+ *
+ * The store listener runs in the context of each publisher. Publishers
+ * serialize on a spinlock, which also keeps a write from being preempted
+ * on a single core, and bump the generation counter around the copy. The
+ * consumer copies the whole @ref measurement_data and retries if the
+ * counter was odd or changed.
+ */
+
+#include "measurement.h"
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
+#include <string.h>
+
+/**
+ * @brief Latest samples, written by @ref store_listener_cb() only.
+ */
+static struct {
+    atomic_t gen;                 /**< Generation counter, odd while a write is in progress. */
+    struct k_spinlock write_lock; /**< Serializes the publishers. */
+    struct measurement_data data; /**< Latest samples. */
+} store;
+
+/**
+ * @brief Copies @p len bytes into the store inside a write section.
+ */
+static void store_write(void *dst, const void *src, size_t len)
+{
+    k_spinlock_key_t key = k_spin_lock(&store.write_lock);
+
+    atomic_inc(&store.gen);
+    barrier_dmem_fence_full();
+    memcpy(dst, src, len);
+    barrier_dmem_fence_full();
+    atomic_inc(&store.gen);
+
+    k_spin_unlock(&store.write_lock, key);
+}
+
+/**
+ * @brief zbus listener: stores every published sample.
+ *
+ * @param chan Channel the sample was published on.
+ */
+static void store_listener_cb(const struct zbus_channel *chan)
+{
+    const void *msg = zbus_chan_const_msg(chan);
+
+    if (chan == &env_chan) {
+        store_write(&store.data.env, msg, sizeof(store.data.env));
+    } else if (chan == &accel_chan) {
+        store_write(&store.data.accel, msg, sizeof(store.data.accel));
+    } else if (chan == &gps_chan) {
+        store_write(&store.data.gps, msg, sizeof(store.data.gps));
+    }
+}
+
+ZBUS_LISTENER_DEFINE(measurement_store_lis, store_listener_cb);
+ZBUS_CHAN_ADD_OBS(env_chan, measurement_store_lis, 1);
+ZBUS_CHAN_ADD_OBS(accel_chan, measurement_store_lis, 1);
+ZBUS_CHAN_ADD_OBS(gps_chan, measurement_store_lis, 1);
+
+void measurement_snapshot(struct measurement_data *out)
+{
+    atomic_val_t gen;
+
+    do {
+        gen = atomic_get(&store.gen);
+        if (gen & 1) {
+            /* A writer on another core is mid-update */
+            k_yield();
+            continue;
+        }
+
+        barrier_dmem_fence_full();
+        memcpy(out, &store.data, sizeof(*out));
+        barrier_dmem_fence_full();
+    } while ((gen & 1) || atomic_get(&store.gen) != gen);
+}
@@ -0,0 +1,40 @@
+/**
+ * @file measurement.h
+ * @brief Seqlock-protected store of the latest measurements.
+ *
+ * A zbus listener copies every sample published on @c env_chan,
+ * @c accel_chan and @c gps_chan into a plain structure, bumping a
+ * generation counter before and after the copy (odd while a write is in
+ * progress). The uplink builder copies a coherent snapshot of all samples
+ * without ever blocking a producer and simply retries when a write
+ * overlapped its copy.
+ *
+ * Functions:
+ *  - @ref measurement_snapshot() to copy all samples coherently.
+ */
+
+#ifndef MEASUREMENT_H
+#define MEASUREMENT_H
+
+#include "channels.h"
+
+/**
+ * @brief Coherent copy of the latest samples.
+ */
+struct measurement_data {
+    struct env_sample env;      /**< Latest environment sensors sample. */
+    struct accel_sample accel;  /**< Latest accelerometer reading. */
+    struct gps_sample gps;      /**< Latest GPS position. */
+};
+
+/**
+ * @brief Copies a coherent snapshot of the latest samples.
+ *
+ * Retries while a sample is being stored, so every field of a sample
+ * belongs to the same publication.
+ *
+ * @param out Pointer to store the snapshot.
+ */
+void measurement_snapshot(struct measurement_data *out);
+
+#endif /* MEASUREMENT_H */
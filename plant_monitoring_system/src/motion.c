@@ -0,0 +1,130 @@
+/**
+ * @file motion.c
+ * @brief Motion monitor: detects moves and tilts from accelerometer samples.
+ *
+ * A node at rest only measures gravity, so any axis changing by more than
+ * @ref ACCEL_MOTION_THRESHOLD between two samples published on
+ * @c accel_chan means it has been moved or tilted. When the accelerometer
+ * streams its FIFO, each block on @c accel_block_chan is also checked for
+ * vibration: shaking or handling that the block mean averages out still
+ * shows up as a large RMS deviation from that mean. Each detection is
+ * published on @c motion_chan with a running count, which the GPS thread
+ * compares against the value seen at its last fix.
+ */
+
+#include "channels.h"
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <stdbool.h>
+#include <math.h>
+
+/* --- Motion detection ------------------------------------------------------- */
+#define ACCEL_MOTION_THRESHOLD 100  /**< Per-axis change (m/s² ×100) counted as motion (~6° of tilt). */
+#define ACCEL_VIBRATION_RMS 50      /**< Block RMS deviation (m/s² ×100) counted as vibration. */
+
+/*
+ * Both listeners run in the context of the publisher and share this state.
+ * @c accel_chan is written either by the sensors thread (polling) or by the
+ * accel stream work item on the system work queue, which is also the only
+ * writer of @c accel_block_chan. The two never run at the same time: main()
+ * sets the accelerometer polling period to 0 once the stream has started,
+ * so the sensors thread stops reading it. No locking is therefore needed.
+ */
+static struct motion_event event;
+
+/**
+ * @brief Publishes one motion detection on @c motion_chan.
+ *
+ * @param timestamp Unix epoch of the detection (s), 0 if unknown.
+ */
+static void motion_report(uint32_t timestamp)
+{
+    event.timestamp = timestamp;
+    event.count++;
+    zbus_chan_pub(&motion_chan, &event, CHANNEL_TIMEOUT);
+}
+
+/**
+ * @brief zbus listener: compares each accelerometer sample with the previous one.
+ *
+ * @param chan @c accel_chan.
+ */
+static void motion_listener_cb(const struct zbus_channel *chan)
+{
+    static struct accel_sample last;
+    static bool has_last;
+
+    const struct accel_sample *now = zbus_chan_const_msg(chan);
+
+    if (has_last) {
+        int32_t delta[3] = { now->x - last.x, now->y - last.y, now->z - last.z };
+
+        for (int i = 0; i < 3; i++) {
+            if (delta[i] > ACCEL_MOTION_THRESHOLD || delta[i] < -ACCEL_MOTION_THRESHOLD) {
+                printk("[MOTION] - Motion detected (%u)\n", event.count + 1);
+                motion_report(now->timestamp);
+                break;
+            }
+        }
+    }
+
+    last = *now;
+    has_last = true;
+}
+
+/**
+ * @brief zbus listener: measures the vibration within each FIFO block.
+ *
+ * Computes the peak and RMS deviation of the block samples from the block
+ * mean (gravity and a steady tilt cancel out) and reports motion when the
+ * RMS exceeds @ref ACCEL_VIBRATION_RMS.
+ *
+ * @param chan @c accel_block_chan.
+ */
+static void vibration_listener_cb(const struct zbus_channel *chan)
+{
+    const struct accel_block *block = zbus_chan_const_msg(chan);
+    int32_t sum[3] = {0};
+    uint32_t peak = 0;
+    uint64_t sq = 0;
+
+    if (block->count < 2) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < block->count; i++) {
+        sum[0] += block->samples[i].x;
+        sum[1] += block->samples[i].y;
+        sum[2] += block->samples[i].z;
+    }
+
+    for (uint8_t i = 0; i < block->count; i++) {
+        int32_t d[3] = {
+            block->samples[i].x - sum[0] / block->count,
+            block->samples[i].y - sum[1] / block->count,
+            block->samples[i].z - sum[2] / block->count,
+        };
+
+        for (int axis = 0; axis < 3; axis++) {
+            uint32_t mag = (uint32_t)(d[axis] < 0 ? -d[axis] : d[axis]);
+
+            peak = MAX(peak, mag);
+            sq += (uint64_t)(d[axis] * d[axis]);
+        }
+    }
+
+    /* RMS of the deviation vector: mean over samples of dx² + dy² + dz² */
+    uint32_t rms = (uint32_t)sqrtf((float)(sq / block->count));
+
+    if (rms > ACCEL_VIBRATION_RMS) {
+        printk("[MOTION] - Vibration detected (%u): RMS %u, peak %u (m/s² x100)\n",
+               event.count + 1, rms, peak);
+        motion_report(block->timestamp);
+    }
+}
+
+ZBUS_LISTENER_DEFINE(motion_lis, motion_listener_cb);
+ZBUS_CHAN_ADD_OBS(accel_chan, motion_lis, 2);
+
+ZBUS_LISTENER_DEFINE(vibration_lis, vibration_listener_cb);
+ZBUS_CHAN_ADD_OBS(accel_block_chan, vibration_lis, 2);
@@ -2,57 +2,143 @@
  * @file adc.c
  * @brief ADC driver implementation for multi-channel analog input using Zephyr.
  *
- * This module implements ADC initialization and data acquisition routines
- * for dynamic, per-channel configuration. It supports reading raw digital
- * values, normalized floating-point samples, and voltage readings in millivolts.
+ * This module implements ADC initialization and data acquisition routines.
+ * Channels are set up once at initialization; reads convert one or several
+ * channels in a single, optionally oversampled, sequence. It supports
+ * reading raw digital values, normalized floating-point samples, and
+ * voltage readings in millivolts, and a continuous mode that samples the
+ * channels at a fixed interval and reduces them to per-interval statistics.
  */
 
 #include "adc.h"
 #include <zephyr/drivers/adc.h>
+#include <zephyr/drivers/gpio.h>
 #include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
 
-/** @brief Static buffer used for single-sample ADC conversions. */
-static int16_t sample_buffer[BUFFER_SIZE];
+#ifdef CONFIG_ADC_ASYNC
+/* adc_stream::state bits */
+#define ADC_STREAM_RUNNING 0 /**< A sequence is in progress. */
+#define ADC_STREAM_STOP    1 /**< A snapshot read asked the sequence to finish. */
+
+static struct adc_stream *active_stream; /**< Running stream, NULL if none. */
+#endif
+
+/* --- Sensor supply ------------------------------------------------------------ */
 
 /**
- * @brief Initializes the specified ADC device.
+ * @brief Configures a sensor supply switch, off, on first use.
  *
- * Verifies that the ADC device referenced in the configuration is ready
- * for operation. This function does not configure ADC channels; they are
- * set up dynamically during each read operation.
+ * @param power Sensor supply shared by one or several channels.
+ * @retval 0 If the supply is ready (or has no switch).
+ * @retval -ENODEV If the GPIO controller is not ready.
+ * @retval Negative error code from @ref gpio_pin_configure_dt on failure.
+ */
+static int adc_power_init(struct adc_power *power)
+{
+    int ret = 0;
+
+    if (power->gpio.port == NULL) {
+        return 0;
+    }
+
+    if (!power->initialized) {
+        k_mutex_init(&power->lock);
+        if (!gpio_is_ready_dt(&power->gpio)) {
+            printk("[ADC] - Sensor supply GPIO is not ready\n");
+            return -ENODEV;
+        }
+        ret = gpio_pin_configure_dt(&power->gpio, GPIO_OUTPUT_INACTIVE);
+        power->initialized = (ret == 0);
+    }
+    return ret;
+}
+
+/**
+ * @brief Takes a reference on a sensor supply, switching it on if needed.
  *
- * @param cfg Pointer to the ADC configuration structure.
- * @retval 0 If the ADC device is ready.
- * @retval -ENODEV If the device is not available or not ready.
+ * @param power Sensor supply, or NULL for an always powered sensor.
+ * @return Time left (ms) until the output settles, or a negative error code.
  */
-int adc_init(const struct adc_config *cfg)
+int adc_power_get(struct adc_power *power)
 {
-    printk("[ADC] - Initializing ADC device %s...\n", cfg->dev->name);
+    int ret = 0;
 
-    if (!device_is_ready(cfg->dev)) {
-        printk("[ADC] - ADC device %s is not ready\n", cfg->dev->name);
-        return -ENODEV;
+    if (power == NULL || power->gpio.port == NULL) {
+        return 0;
     }
 
-    printk("[ADC] - ADC device %s initialized successfully\n", cfg->dev->name);
-    return 0;
+    k_mutex_lock(&power->lock, K_FOREVER);
+    if (power->users == 0) {
+        ret = gpio_pin_set_dt(&power->gpio, 1);
+        power->ready_at = k_uptime_get() + power->settle_ms;
+    }
+    if (ret == 0) {
+        power->users++;
+    }
+    k_mutex_unlock(&power->lock);
+
+    return (ret < 0) ? ret : (int)adc_power_settle_left(power);
 }
 
 /**
- * @brief Reads a raw ADC sample from the configured channel.
+ * @brief Drops a reference on a sensor supply, switching it off with the last one.
  *
- * Dynamically sets up the specified ADC channel using the provided
- * configuration parameters, performs a single conversion, and returns
- * the unprocessed raw sample value.
+ * @param power Sensor supply, or NULL for an always powered sensor.
+ */
+void adc_power_put(struct adc_power *power)
+{
+    if (power == NULL || power->gpio.port == NULL) {
+        return;
+    }
+
+    k_mutex_lock(&power->lock, K_FOREVER);
+    if (power->users > 0 && --power->users == 0) {
+        gpio_pin_set_dt(&power->gpio, 0);
+    }
+    k_mutex_unlock(&power->lock);
+}
+
+/**
+ * @brief Time left until a sensor supply settles.
+ *
+ * @param power Sensor supply, or NULL for an always powered sensor.
+ * @return Milliseconds left, 0 if settled.
+ */
+uint32_t adc_power_settle_left(struct adc_power *power)
+{
+    if (power == NULL || power->gpio.port == NULL) {
+        return 0;
+    }
+
+    int64_t left = power->ready_at - k_uptime_get();
+
+    return (left > 0) ? (uint32_t)left : 0;
+}
+
+/* --- Channels -------------------------------------------------------------- */
+
+/**
+ * @brief Initializes the specified ADC device and channel.
+ *
+ * Verifies that the ADC device referenced in the configuration is ready
+ * and sets the channel up; the setup is not repeated on each read. The
+ * switched supply of the sensor, if any, is configured off.
  *
  * @param cfg Pointer to the ADC configuration structure.
- * @param raw_val Pointer to store the raw ADC sample.
- * @retval 0 If the conversion was successful.
- * @retval -EIO If the ADC read operation failed.
- * @retval Negative error code from @ref adc_channel_setup on setup failure.
+ * @retval 0 If the ADC device is ready and the channel configured.
+ * @retval -ENODEV If the device or the supply GPIO is not ready.
+ * @retval Negative error code from @ref adc_channel_setup or the GPIO driver on failure.
  */
-int adc_read_raw(const struct adc_config *cfg, int16_t *raw_val)
+int adc_init(const struct adc_config *cfg)
 {
+    printk("[ADC] - Initializing ADC device %s...\n", cfg->dev->name);
+
+    if (!device_is_ready(cfg->dev)) {
+        printk("[ADC] - ADC device %s is not ready\n", cfg->dev->name);
+        return -ENODEV;
+    }
+
     struct adc_channel_cfg channel_cfg = {
         .gain             = cfg->gain,
         .reference        = cfg->ref,
@@ -62,27 +148,191 @@ int adc_read_raw(const struct adc_config *cfg, int16_t *raw_val)
 
     int ret = adc_channel_setup(cfg->dev, &channel_cfg);
     if (ret < 0) {
-        printk("ADC channel setup failed (%d)\n", ret);
+        printk("[ADC] - Channel %u setup failed (%d)\n", cfg->channel_id, ret);
+        return ret;
+    }
+
+    if (cfg->power != NULL) {
+        ret = adc_power_init(cfg->power);
+        if (ret < 0) {
+            return ret;
+        }
+    }
+
+    printk("[ADC] - ADC device %s channel %u initialized successfully\n", cfg->dev->name, cfg->channel_id);
+    return 0;
+}
+
+/**
+ * @brief Converts a raw sample to millivolts.
+ */
+static int32_t raw_to_mv(const struct adc_config *cfg, int16_t raw_val)
+{
+    return ((int32_t)raw_val * cfg->vref_mv) / ((1 << cfg->resolution) - 1);
+}
+
+/**
+ * @brief Builds the channel mask of a scan sequence.
+ *
+ * @param cfgs Channel configurations.
+ * @param count Number of channels.
+ * @param channels Bit mask of the channels.
+ * @retval 0 If the channels can share a sequence.
+ * @retval -EINVAL If they differ in device, resolution or oversampling, or repeat.
+ */
+static int adc_scan_channels(const struct adc_config *const *cfgs, size_t count, uint32_t *channels)
+{
+    *channels = 0;
+
+    if (count == 0 || count > ADC_SCAN_MAX_CHANNELS) {
+        return -EINVAL;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (cfgs[i]->dev != cfgs[0]->dev || cfgs[i]->resolution != cfgs[0]->resolution ||
+            cfgs[i]->oversampling != cfgs[0]->oversampling || (*channels & BIT(cfgs[i]->channel_id))) {
+            return -EINVAL;
+        }
+        *channels |= BIT(cfgs[i]->channel_id);
+    }
+    return 0;
+}
+
+/**
+ * @brief Index of a channel among the converted ones (results are in ascending channel order).
+ */
+static size_t adc_scan_slot(uint32_t channels, const struct adc_config *cfg)
+{
+    return __builtin_popcount(channels & (BIT(cfg->channel_id) - 1));
+}
+
+#ifdef CONFIG_ADC_ASYNC
+
+static void adc_stream_restart(struct adc_stream *stream);
+
+/**
+ * @brief Stops the stream running on a device ahead of a snapshot read.
+ *
+ * The sampling callback finishes the sequence at the next sampling, so the
+ * following @ref adc_read only waits for one interval.
+ *
+ * @param dev ADC device about to be read.
+ * @return The paused stream, to give to @ref adc_stream_resume(), or NULL.
+ */
+static struct adc_stream *adc_stream_pause(const struct device *dev)
+{
+    struct adc_stream *stream = active_stream;
+
+    if (stream == NULL || stream->cfgs[0]->dev != dev) {
+        return NULL;
+    }
+
+    k_mutex_lock(&stream->ctl, K_FOREVER);
+    atomic_set_bit(&stream->state, ADC_STREAM_STOP);
+    return stream;
+}
+
+/**
+ * @brief Restarts a stream paused by @ref adc_stream_pause().
+ *
+ * The block reductions still queued are completed first, as the new
+ * sequence writes the buffer from its start.
+ *
+ * @param stream Paused stream, or NULL.
+ */
+static void adc_stream_resume(struct adc_stream *stream)
+{
+    struct k_work_sync sync;
+
+    if (stream == NULL) {
+        return;
+    }
+
+    atomic_clear_bit(&stream->state, ADC_STREAM_STOP);
+    for (size_t i = 0; i < ARRAY_SIZE(stream->halves); i++) {
+        k_work_flush(&stream->halves[i].work, &sync);
+    }
+    if (!atomic_test_bit(&stream->state, ADC_STREAM_RUNNING)) {
+        adc_stream_restart(stream);
+    }
+    k_mutex_unlock(&stream->ctl);
+}
+
+#else
+
+static inline struct adc_stream *adc_stream_pause(const struct device *dev)
+{
+    ARG_UNUSED(dev);
+    return NULL;
+}
+
+static inline void adc_stream_resume(struct adc_stream *stream)
+{
+    ARG_UNUSED(stream);
+}
+
+#endif /* CONFIG_ADC_ASYNC */
+
+/**
+ * @brief Converts several channels in one sequence.
+ *
+ * The driver stores one result per channel in ascending channel order;
+ * they are mapped back to the order of @p cfgs.
+ *
+ * @param cfgs Channel configurations.
+ * @param count Number of channels.
+ * @param raw Raw results, in the order of @p cfgs.
+ * @return 0 on success, negative error code on failure.
+ */
+static int adc_read_scan(const struct adc_config *const *cfgs, size_t count, int16_t *raw)
+{
+    int16_t results[ADC_SCAN_MAX_CHANNELS];
+    uint32_t channels = 0;
+
+    int ret = adc_scan_channels(cfgs, count, &channels);
+    if (ret < 0) {
         return ret;
     }
 
     struct adc_sequence sequence = {
-        .channels    = BIT(cfg->channel_id),
-        .buffer      = sample_buffer,
-        .buffer_size = sizeof(sample_buffer),
-        .resolution  = cfg->resolution,
+        .channels     = channels,
+        .buffer       = results,
+        .buffer_size  = count * sizeof(results[0]),
+        .resolution   = cfgs[0]->resolution,
+        .oversampling = cfgs[0]->oversampling,
     };
 
-    ret = adc_read(cfg->dev, &sequence);
+    struct adc_stream *paused = adc_stream_pause(cfgs[0]->dev);
+
+    ret = adc_read(cfgs[0]->dev, &sequence);
+    adc_stream_resume(paused);
     if (ret < 0) {
-        printk("ADC read failed (%d)\n", ret);
+        printk("[ADC] - Read failed (%d)\n", ret);
         return ret;
     }
 
-    *raw_val = sample_buffer[0];
+    for (size_t i = 0; i < count; i++) {
+        raw[i] = results[adc_scan_slot(channels, cfgs[i])];
+    }
     return 0;
 }
 
+/**
+ * @brief Reads a raw ADC sample from the configured channel.
+ *
+ * Performs a single (oversampled) conversion of the channel set up by
+ * @ref adc_init and returns the unprocessed raw sample value.
+ *
+ * @param cfg Pointer to the ADC configuration structure.
+ * @param raw_val Pointer to store the raw ADC sample.
+ * @retval 0 If the conversion was successful.
+ * @retval Negative error code from @ref adc_read on failure.
+ */
+int adc_read_raw(const struct adc_config *cfg, int16_t *raw_val)
+{
+    return adc_read_scan(&cfg, 1, raw_val);
+}
+
 /**
  * @brief Reads and normalizes an ADC sample (0.0–1.0 range).
  *
@@ -113,17 +363,226 @@ float adc_read_normalized(const struct adc_config *cfg)
  * @param cfg Pointer to the ADC configuration structure.
  * @param out_mv Pointer to store the resulting voltage in millivolts.
  * @retval 0 If the voltage computation was successful.
- * @retval -EIO If the ADC read failed.
- * @retval Negative error code from @ref adc_read_raw on failure.
+ * @retval Negative error code from @ref adc_read_voltages on failure.
  */
 int adc_read_voltage(const struct adc_config *cfg, int32_t *out_mv)
 {
-    int16_t raw_val = 0;
-    int ret = adc_read_raw(cfg, &raw_val);
+    return adc_read_voltages(&cfg, 1, out_mv);
+}
+
+/**
+ * @brief Converts several channels in one sequence and scales them to millivolts.
+ *
+ * @param cfgs Channel configurations.
+ * @param count Number of channels.
+ * @param out_mv Voltages in millivolts, in the order of @p cfgs.
+ * @retval 0 If every conversion was successful.
+ * @retval Negative error code from @ref adc_read_scan on failure.
+ */
+int adc_read_voltages(const struct adc_config *const *cfgs, size_t count, int32_t *out_mv)
+{
+    int16_t raw[ADC_SCAN_MAX_CHANNELS];
+
+    int ret = adc_read_scan(cfgs, count, raw);
     if (ret < 0) {
         return ret;
     }
 
-    *out_mv = ((int32_t)raw_val * cfg->vref_mv) / ((1 << cfg->resolution) - 1);
+    for (size_t i = 0; i < count; i++) {
+        out_mv[i] = raw_to_mv(cfgs[i], raw[i]);
+    }
     return 0;
 }
+
+/* --- Continuous mode --------------------------------------------------------- */
+
+#ifdef CONFIG_ADC_ASYNC
+
+/**
+ * @brief Sampling callback (ADC interrupt context).
+ *
+ * Hands each completed half of the buffer to the work queue; the driver
+ * keeps filling the other half meanwhile. A pending snapshot read ends the
+ * sequence at once and the block in progress is dropped.
+ */
+static enum adc_action adc_stream_sampling_done(const struct device *dev,
+                                                const struct adc_sequence *sequence,
+                                                uint16_t sampling_index)
+{
+    struct adc_stream *stream = sequence->options->user_data;
+
+    ARG_UNUSED(dev);
+
+    if (atomic_test_bit(&stream->state, ADC_STREAM_STOP)) {
+        atomic_clear_bit(&stream->state, ADC_STREAM_RUNNING);
+        return ADC_ACTION_FINISH;
+    }
+
+    if (sampling_index == ADC_STREAM_BLOCK - 1) {
+        k_work_submit(&stream->halves[0].work);
+    } else if (sampling_index == 2 * ADC_STREAM_BLOCK - 1) {
+        /* Last sampling of the sequence */
+        atomic_clear_bit(&stream->state, ADC_STREAM_RUNNING);
+        k_work_submit(&stream->halves[1].work);
+    }
+    return ADC_ACTION_CONTINUE;
+}
+
+/**
+ * @brief Starts a new sequence from the start of the buffer.
+ *
+ * Called with @c stream->ctl held, so it never races a snapshot read.
+ */
+static void adc_stream_restart(struct adc_stream *stream)
+{
+    atomic_set_bit(&stream->state, ADC_STREAM_RUNNING);
+
+    int ret = adc_read_async(stream->cfgs[0]->dev, &stream->sequence, NULL);
+    if (ret < 0) {
+        atomic_clear_bit(&stream->state, ADC_STREAM_RUNNING);
+        printk("[ADC] - Continuous sampling stopped (%d)\n", ret);
+    }
+}
+
+/**
+ * @brief Reduces one half of the buffer and accumulates the block values.
+ *
+ * The decimator is a first-order CIC: the block is summed and the sum
+ * shifted by @ref ADC_STREAM_BLOCK_LOG2, i.e. the moving average of
+ * @ref ADC_STREAM_BLOCK samplings taken once per block. The sequence ends
+ * with the second half, so it is restarted before that half is reduced,
+ * unless a snapshot read holds the stream: that read restarts it itself, so
+ * the work queue never waits for the ADC.
+ */
+static void adc_stream_work_handler(struct k_work *work)
+{
+    struct adc_stream_half *half = CONTAINER_OF(work, struct adc_stream_half, work);
+    struct adc_stream *stream = half->stream;
+    const int16_t *block = &stream->buf[half->index * ADC_STREAM_BLOCK * stream->count];
+
+    if (half->index == 1 && k_mutex_lock(&stream->ctl, K_NO_WAIT) == 0) {
+        if (!atomic_test_bit(&stream->state, ADC_STREAM_RUNNING)) {
+            adc_stream_restart(stream);
+        }
+        k_mutex_unlock(&stream->ctl);
+    }
+
+    for (size_t i = 0; i < stream->count; i++) {
+        int32_t sum = 0;
+
+        for (size_t s = 0; s < ADC_STREAM_BLOCK; s++) {
+            sum += block[s * stream->count + stream->slot[i]];
+        }
+
+        int32_t mv = raw_to_mv(stream->cfgs[i],
+                               (int16_t)((sum + ADC_STREAM_BLOCK / 2) >> ADC_STREAM_BLOCK_LOG2));
+        k_spinlock_key_t key = k_spin_lock(&stream->lock);
+
+        if (stream->acc[i].blocks == 0 || mv < stream->acc[i].min) {
+            stream->acc[i].min = mv;
+        }
+        if (stream->acc[i].blocks == 0 || mv > stream->acc[i].max) {
+            stream->acc[i].max = mv;
+        }
+        stream->acc[i].sum += mv;
+        stream->acc[i].blocks++;
+        k_spin_unlock(&stream->lock, key);
+    }
+}
+
+/**
+ * @brief Starts continuous sampling into the ping-pong buffer.
+ *
+ * @param stream Stream with its configuration fields set.
+ * @retval 0 If sampling started.
+ * @retval -EINVAL If the channels cannot share a sequence.
+ * @retval Negative error code from @ref adc_read_async on failure.
+ */
+int adc_stream_start(struct adc_stream *stream)
+{
+    uint32_t channels;
+
+    int ret = adc_scan_channels(stream->cfgs, stream->count, &channels);
+    if (ret < 0) {
+        return ret;
+    }
+
+    for (size_t i = 0; i < stream->count; i++) {
+        stream->slot[i] = adc_scan_slot(channels, stream->cfgs[i]);
+    }
+    k_mutex_init(&stream->ctl);
+    atomic_clear(&stream->state);
+    for (uint8_t i = 0; i < ARRAY_SIZE(stream->halves); i++) {
+        stream->halves[i].stream = stream;
+        stream->halves[i].index = i;
+        k_work_init(&stream->halves[i].work, adc_stream_work_handler);
+    }
+
+    stream->options = (struct adc_sequence_options) {
+        .interval_us     = stream->interval_us,
+        .callback        = adc_stream_sampling_done,
+        .user_data       = stream,
+        .extra_samplings = 2 * ADC_STREAM_BLOCK - 1,
+    };
+    stream->sequence = (struct adc_sequence) {
+        .options      = &stream->options,
+        .channels     = channels,
+        .buffer       = stream->buf,
+        .buffer_size  = 2 * ADC_STREAM_BLOCK * stream->count * sizeof(stream->buf[0]),
+        .resolution   = stream->cfgs[0]->resolution,
+        .oversampling = stream->cfgs[0]->oversampling,
+    };
+
+    /* Streamed sensors stay powered; the first block may include the settling */
+    for (size_t i = 0; i < stream->count; i++) {
+        adc_power_get(stream->cfgs[i]->power);
+    }
+
+    atomic_set_bit(&stream->state, ADC_STREAM_RUNNING);
+    ret = adc_read_async(stream->cfgs[0]->dev, &stream->sequence, NULL);
+    if (ret < 0) {
+        atomic_clear_bit(&stream->state, ADC_STREAM_RUNNING);
+        printk("[ADC] - Continuous sampling start failed (%d)\n", ret);
+        for (size_t i = 0; i < stream->count; i++) {
+            adc_power_put(stream->cfgs[i]->power);
+        }
+        return ret;
+    }
+    active_stream = stream;
+
+    printk("[ADC] - Continuous sampling of %u channels every %u us\n",
+           (unsigned int)stream->count, stream->interval_us);
+    return 0;
+}
+
+#else
+
+int adc_stream_start(struct adc_stream *stream)
+{
+    ARG_UNUSED(stream);
+    return -ENOTSUP;
+}
+
+#endif /* CONFIG_ADC_ASYNC */
+
+/**
+ * @brief Takes the statistics accumulated since the previous call and resets them.
+ *
+ * @param stream Running stream.
+ * @param stats Statistics, in the order of @c stream->cfgs.
+ */
+void adc_stream_take(struct adc_stream *stream, struct adc_stats *stats)
+{
+    k_spinlock_key_t key = k_spin_lock(&stream->lock);
+
+    for (size_t i = 0; i < stream->count; i++) {
+        stats[i].blocks = stream->acc[i].blocks;
+        stats[i].min_mv = stream->acc[i].min;
+        stats[i].max_mv = stream->acc[i].max;
+        stats[i].mean_mv = (stream->acc[i].blocks > 0) ?
+                           (int32_t)(stream->acc[i].sum / stream->acc[i].blocks) : 0;
+        stream->acc[i].sum = 0;
+        stream->acc[i].blocks = 0;
+    }
+    k_spin_unlock(&stream->lock, key);
+}
@@ -14,10 +14,38 @@
 #define ADC_H
 
 #include <zephyr/drivers/adc.h>
+#include <zephyr/drivers/gpio.h>
 #include <zephyr/kernel.h>
+#include <stdbool.h>
 
-/** @brief ADC sample buffer size (number of samples per read). */
-#define BUFFER_SIZE 1
+/** @brief Maximum number of channels converted in one scan sequence. */
+#define ADC_SCAN_MAX_CHANNELS 4
+
+/** @brief log2 of the samplings per continuous-mode block (decimation factor). */
+#define ADC_STREAM_BLOCK_LOG2 5
+/** @brief Samplings per continuous-mode block; the buffer holds two (ping-pong). */
+#define ADC_STREAM_BLOCK (1 << ADC_STREAM_BLOCK_LOG2)
+
+/**
+ * @brief GPIO-switched sensor supply.
+ *
+ * Powers one or several analog sensors only while they are converted.
+ * Users take a reference before converting and drop it afterwards; the
+ * supply is switched on by the first reference and off with the last, so
+ * sensors converted together share one power window and one settle time.
+ *
+ * Only the first fields are configuration; the rest is private state.
+ */
+struct adc_power {
+    struct gpio_dt_spec gpio;      /**< Supply switch (active = powered); no port means always powered. */
+    uint32_t settle_ms;            /**< Time from power-on to a valid output (ms). */
+
+    /* Private */
+    struct k_mutex lock;           /**< Protects the reference count. */
+    uint8_t users;                 /**< References taken. */
+    int64_t ready_at;              /**< Uptime the output settles (ms). */
+    bool initialized;              /**< GPIO configured. */
+};
 
 /**
  * @brief ADC channel configuration structure.
@@ -34,13 +62,16 @@ struct adc_config {
     enum adc_reference ref;        /**< Voltage reference source for conversion. */
     uint32_t acquisition_time;     /**< Sampling acquisition time in microseconds. */
     int32_t vref_mv;               /**< Reference voltage in millivolts. */
+    uint8_t oversampling;          /**< Hardware oversampling: 2^n conversions averaged per result. */
+    struct adc_power *power;       /**< Switched supply of the sensor, NULL if always powered. */
 };
 
 /**
  * @brief Initializes the ADC hardware and specified channel.
  *
  * Configures the ADC driver for the given channel parameters
- * (resolution, gain, reference, and acquisition time).
+ * (gain, reference, and acquisition time) once; reads only run the
+ * conversion sequence. A switched supply is configured off.
  *
  * @param cfg Pointer to the ADC configuration structure.
  * @retval 0 If initialization was successful.
@@ -49,6 +80,30 @@ struct adc_config {
  */
 int adc_init(const struct adc_config *cfg);
 
+/**
+ * @brief Takes a reference on a sensor supply, switching it on if needed.
+ *
+ * @param power Sensor supply, or NULL for an always powered sensor.
+ * @return Time left (ms) until the output settles (0 if already settled),
+ *         or a negative error code from the GPIO driver.
+ */
+int adc_power_get(struct adc_power *power);
+
+/**
+ * @brief Drops a reference on a sensor supply, switching it off with the last one.
+ *
+ * @param power Sensor supply, or NULL for an always powered sensor.
+ */
+void adc_power_put(struct adc_power *power);
+
+/**
+ * @brief Time left until a sensor supply settles.
+ *
+ * @param power Sensor supply, or NULL for an always powered sensor.
+ * @return Milliseconds left, 0 if settled.
+ */
+uint32_t adc_power_settle_left(struct adc_power *power);
+
 /**
  * @brief Reads a raw ADC value from the configured channel.
  *
@@ -86,4 +141,99 @@ float adc_read_normalized(const struct adc_config *cfg);
  */
 int adc_read_voltage(const struct adc_config *cfg, int32_t *out_mv);
 
+/**
+ * @brief Converts several channels of one ADC in a single scan sequence.
+ *
+ * All channels share the sequence, so they must use the same device,
+ * resolution and oversampling (taken from @p cfgs[0]).
+ *
+ * @param cfgs Channel configurations (initialized with @ref adc_init()).
+ * @param count Number of channels (at most @ref ADC_SCAN_MAX_CHANNELS).
+ * @param out_mv Voltages in millivolts, in the order of @p cfgs.
+ * @retval 0 If every conversion was successful.
+ * @retval -EINVAL If the channels cannot share a sequence.
+ * @retval Negative error code from @ref adc_read on failure.
+ */
+int adc_read_voltages(const struct adc_config *const *cfgs, size_t count, int32_t *out_mv);
+
+/**
+ * @brief Statistics of one channel over a reporting interval.
+ *
+ * Computed from the decimated block means, so a single noisy conversion
+ * cannot become the minimum or maximum.
+ */
+struct adc_stats {
+    int32_t min_mv;                /**< Lowest block mean (mV). */
+    int32_t mean_mv;               /**< Mean of the block means (mV). */
+    int32_t max_mv;                /**< Highest block mean (mV). */
+    uint32_t blocks;               /**< Blocks reduced in the interval (0 if none). */
+};
+
+/**
+ * @brief Continuous sampling of several channels of one ADC.
+ *
+ * The channels are converted every @c interval_us into a two-block
+ * ping-pong buffer. Each completed block is reduced on the system work
+ * queue by a first-order CIC (moving-average) decimator to one value per
+ * channel, while the driver fills the other block; the block values are
+ * accumulated into @ref adc_stats until taken with @ref adc_stream_take().
+ *
+ * Only the first fields are configuration; the rest is private state.
+ */
+struct adc_stream {
+    const struct adc_config *cfgs[ADC_SCAN_MAX_CHANNELS]; /**< Channels (same device, resolution and oversampling). */
+    size_t count;                  /**< Number of channels. */
+    uint32_t interval_us;          /**< Interval between samplings (µs). */
+
+    /* Private */
+    int16_t buf[2 * ADC_STREAM_BLOCK * ADC_SCAN_MAX_CHANNELS]; /**< Ping-pong sample buffer. */
+    uint8_t slot[ADC_SCAN_MAX_CHANNELS];   /**< Position of each channel in a sampling. */
+    struct adc_sequence_options options;   /**< Repetition and block callback. */
+    struct adc_sequence sequence;          /**< Sequence restarted after each buffer. */
+    struct adc_stream_half {
+        struct k_work work;                /**< Reduces this half of the buffer. */
+        struct adc_stream *stream;         /**< Owning stream. */
+        uint8_t index;                     /**< 0 for the ping block, 1 for the pong block. */
+    } halves[2];
+    struct k_mutex ctl;                    /**< Serializes restarts and pauses of the sequence. */
+    atomic_t state;                        /**< ADC_STREAM_* state bits. */
+    struct k_spinlock lock;                /**< Protects the accumulators. */
+    struct {
+        int64_t sum;
+        int32_t min;
+        int32_t max;
+        uint32_t blocks;
+    } acc[ADC_SCAN_MAX_CHANNELS];          /**< Block statistics since the last take. */
+};
+
+/**
+ * @brief Starts continuous sampling.
+ *
+ * The channels must have been set up with @ref adc_init(). Reads of the
+ * same device through this module stop the sequence at its next sampling
+ * (the block in progress is dropped) and restart it once converted, so they
+ * wait for at most one interval and never for a whole buffer; they must not
+ * be made from the system work queue. Switched supplies of the channels
+ * stay on.
+ *
+ * The CPU wakes up for every sampling (timer and ADC interrupts), which
+ * keeps a battery node out of deep sleep: enable it only when the block
+ * statistics are worth that power.
+ *
+ * @param stream Stream with its configuration fields set.
+ * @retval 0 If sampling started.
+ * @retval -ENOTSUP If asynchronous ADC reads are disabled (CONFIG_ADC_ASYNC).
+ * @retval -EINVAL If the channels cannot share a sequence.
+ * @retval Negative error code from @ref adc_read_async on failure.
+ */
+int adc_stream_start(struct adc_stream *stream);
+
+/**
+ * @brief Takes the statistics accumulated since the previous call.
+ *
+ * @param stream Running stream.
+ * @param stats Statistics, in the order of @c stream->cfgs.
+ */
+void adc_stream_take(struct adc_stream *stream, struct adc_stats *stats);
+
 #endif // ADC_H
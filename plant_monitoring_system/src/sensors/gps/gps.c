@@ -1,152 +1,190 @@
 /**
  * @file gps.c
- * @brief GPS UART interrupt handler and NMEA GGA parser implementation.
+ * @brief GPS UART reception, PMTK control and fix publication.
  *
  * This module handles UART-based reception of NMEA sentences from a GPS module.
- * The UART interrupt service routine accumulates incoming data lines, detects
- * complete GGA (or GNGGA) sentences, parses them, and updates the shared
- * GPS data structure. Once new data is available, a semaphore is released
- * to notify waiting threads.
+ * Bytes are received either through a per-byte UART interrupt service routine
+ * or through double-buffered DMA using the UART asynchronous API. Both paths
+ * only push raw bytes into a lock-free single-producer/single-consumer ring
+ * buffer. A dedicated parser thread drains the ring buffer into the streaming
+ * NMEA parser (see nmea.c), which merges GGA, RMC, GSA and VTG sentences into
+ * one fix per NMEA epoch. Each complete epoch is published once, with a
+ * sequence number, and a semaphore is released to notify waiting threads.
  *
  * The design prioritizes simplicity and robustness for embedded systems.
  */
 
 #include "gps.h"
+#include "mtk_bin.h"
 #include <zephyr/kernel.h>
 #include <zephyr/sys/printk.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/uart.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <zephyr/sys/barrier.h>
+#include <zephyr/storage/flash_map.h>
 #include <string.h>
-#include <stdlib.h>
 
-#define BUF_SIZE 128      /**< Maximum NMEA sentence length. */
-#define MAX_FIELDS 16     /**< Maximum number of comma-separated fields per sentence. */
+#define GPS_DMA_BUF_SIZE   64     /**< Size of each DMA reception buffer (bytes). */
+#define GPS_RX_TIMEOUT_US  2000   /**< Line idle time before a partially filled DMA buffer is reported. */
+#define GPS_RX_RING_SIZE   512    /**< Size of the ISR-to-parser ring buffer (bytes). */
+#define GPS_PARSE_CHUNK    32     /**< Bytes drained from the ring buffer per iteration. */
+
+#define GPS_PMTK_MAX_LEN        96   /**< Maximum length of a PMTK command body. */
+#define GPS_PMTK_ACK_TIMEOUT    K_MSEC(1000) /**< Time to wait for a PMTK001 acknowledgement. */
+#define GPS_BAUD_SWITCH_DELAY   K_MSEC(50)   /**< Time for the last byte to leave and the module to switch baud rate. */
+#define GPS_RX_STOP_TIMEOUT     K_MSEC(100)  /**< Time to wait for DMA reception to stop. */
+
+#define GPS_LATEST_MAX_RETRIES  8   /**< Seqlock read attempts before giving up. */
+
+#define GPS_EPO_PARTITION       epo_partition /**< Flash partition holding the EPO image. */
+#define GPS_EPO_ACK_TIMEOUT     K_MSEC(1000)  /**< Time to wait for the acknowledgement of an EPO packet. */
+#define GPS_EPO_MODE_DELAY      K_MSEC(100)   /**< Time for the module to switch between NMEA and binary mode. */
+
+/* PMTK001 acknowledgement flags */
+#define PMTK_ACK_INVALID        0   /**< Invalid command. */
+#define PMTK_ACK_UNSUPPORTED    1   /**< Unsupported command. */
+#define PMTK_ACK_FAILED         2   /**< Valid command, but action failed. */
+#define PMTK_ACK_SUCCESS        3   /**< Valid command, action succeeded. */
+
+/* --- Parser thread configuration -------------------------------------------- */
+#define GPS_PARSER_STACK_SIZE 1024  /**< Stack size allocated for the NMEA parser thread. */
+#define GPS_PARSER_PRIORITY   4     /**< Parser priority (above the GPS measurement thread). */
+
+K_THREAD_STACK_DEFINE(gps_parser_stack, GPS_PARSER_STACK_SIZE); /**< NMEA parser thread stack. */
+static struct k_thread gps_parser_data;                          /**< NMEA parser thread control block. */
 
 static const struct device *uart_dev = NULL;
-static char nmea_line[BUF_SIZE];
-static uint8_t line_pos = 0;
+/** @brief Reception mode selected at initialization. */
+static enum gps_rx_mode rx_mode;
+/** @brief Set while reception is stopped on purpose (e.g. baud rate change). */
+static volatile bool rx_paused;
+/** @brief Signaled when DMA reception has been disabled. */
+static struct k_sem rx_stopped_sem;
+/** @brief Parser context, owned by the parser thread. */
+static struct nmea_parser parser;
 
-/** @brief Internal storage for parsed GPS data. */
-static gps_data_t parsed_data;
-/** @brief Semaphore signaling when a valid GGA frame is available. */
-static struct k_sem parsed_sem;
+/** @brief Double buffer handed to the UART DMA channel in asynchronous mode. */
+static uint8_t rx_dma_buf[2][GPS_DMA_BUF_SIZE];
+/** @brief Index of the DMA buffer to provide on the next buffer request. */
+static uint8_t rx_dma_next;
+
+/** @brief SPSC ring buffer: written only from UART interrupt context, read only by the parser thread. */
+RING_BUF_DECLARE(rx_ring, GPS_RX_RING_SIZE);
+/** @brief Semaphore used by the reception path to wake up the parser thread. */
+static struct k_sem rx_sem;
+/** @brief Number of received bytes dropped because the ring buffer was full. */
+static atomic_t rx_overruns = ATOMIC_INIT(0);
 
 /**
- * @brief Converts an NMEA latitude/longitude string to decimal degrees.
+ * @brief Seqlock-protected slot holding the last published epoch.
  *
- * Converts a coordinate in NMEA format ("DDMM.MMMM" or "DDDMM.MMMM")
- * to standard decimal degrees, applying hemisphere correction based on
- * the direction character.
- *
- * @param nmea Pointer to the NMEA coordinate string.
- * @param dir Direction character ('N', 'S', 'E', or 'W').
- * @return Coordinate in decimal degrees. Returns 0.0f if the input is invalid.
+ * Written only by the parser thread. The generation counter is odd while
+ * the slot is being updated and is bumped again once the copy is complete,
+ * so readers detect a torn copy and retry without ever blocking the writer.
  */
-static float nmea_to_degrees(const char *nmea, char dir)
-{
-    if (!nmea || strlen(nmea) < 4) return 0.0f;
+static struct {
+    atomic_t gen;          /**< Generation counter, odd while a write is in progress. */
+    gps_data_t data;       /**< Last published epoch, stamped with its publication uptime. */
+} latest;
+/** @brief Semaphore signaling when a new epoch has been published. */
+static struct k_sem parsed_sem;
 
-    float value = 0.0f;
-    float decimal = 0.0f;
-    bool seen_dot = false;
-    float divisor = 10.0f;
+/** @brief Last PMTK001 acknowledgement, encoded as (command << 8) | flag. */
+static atomic_t pmtk_ack = ATOMIC_INIT(0);
+/** @brief Semaphore signaling the reception of a PMTK001 acknowledgement. */
+static struct k_sem ack_sem;
+/** @brief Serializes PMTK command/acknowledgement exchanges. */
+static K_MUTEX_DEFINE(pmtk_lock);
 
-    for (int i = 0; nmea[i]; i++) {
-        char c = nmea[i];
-        if (c >= '0' && c <= '9') {
-            if (!seen_dot) {
-                value = value * 10.0f + (c - '0');
-            } else {
-                decimal += (c - '0') / divisor;
-                divisor *= 10.0f;
-            }
-        } else if (c == '.') {
-            seen_dot = true;
-        } else {
-            break;
-        }
-    }
-
-    value += decimal;
+/** @brief Set while the module talks the binary protocol (EPO upload). */
+static volatile bool bin_mode;
+/** @brief Binary packet decoder, used by the parser thread in binary mode. */
+static struct mtk_bin_parser bin_parser;
+/** @brief Last EPO acknowledgement, encoded as (sequence << 8) | result. */
+static atomic_t epo_ack = ATOMIC_INIT(0);
+/** @brief Semaphore signaling the reception of an EPO acknowledgement. */
+static struct k_sem epo_ack_sem;
 
-    //int deg_len = (dir == 'N' || dir == 'S') ? 2 : 3; /* Latitude: 2 digits; longitude: 3 */
-    int degrees = (int)(value / 100.0f);
-    float minutes = value - (degrees * 100.0f);
-    float result = degrees + (minutes / 60.0f);
+/**
+ * @brief Publishes a fused epoch (parser fix callback).
+ *
+ * Copies the fix into the seqlock-protected slot and signals waiting
+ * threads. Runs in the parser thread only.
+ *
+ * @param fix Pointer to the fused fix.
+ * @param user_data Unused.
+ */
+static void gps_publish_fix(const gps_data_t *fix, void *user_data)
+{
+    atomic_inc(&latest.gen);
+    barrier_dmem_fence_full();
+    memcpy(&latest.data, fix, sizeof(gps_data_t));
+    latest.data.uptime = k_uptime_get();
+    barrier_dmem_fence_full();
+    atomic_inc(&latest.gen);
 
-    if (dir == 'S' || dir == 'W') result = -result;
-    return result;
+    k_sem_give(&parsed_sem);
 }
 
 /**
- * @brief Parses a single NMEA GGA sentence and extracts relevant fields.
+ * @brief Records a PMTK001 acknowledgement (parser acknowledgement callback).
  *
- * Extracts latitude, longitude, altitude, HDOP, number of satellites,
- * and UTC time from a GGA sentence. Populates a @ref gps_data_t structure
- * with the parsed values.
+ * Signals the thread waiting in @ref gps_pmtk_command().
  *
- * @param line Pointer to the null-terminated GGA sentence string.
- * @param out Pointer to store the parsed GPS data.
- * @retval true If parsing succeeded and valid data was extracted.
- * @retval false If the sentence was invalid or incomplete.
+ * @param cmd Acknowledged command number.
+ * @param flag Result flag.
+ * @param user_data Unused.
  */
-static bool parse_gga(const char *line, gps_data_t *out)
+static void gps_pmtk_ack(uint16_t cmd, uint8_t flag, void *user_data)
 {
-    char buf[BUF_SIZE];
-    strncpy(buf, line, BUF_SIZE - 1);
-    buf[BUF_SIZE - 1] = '\0';
+    atomic_set(&pmtk_ack, ((atomic_val_t)cmd << 8) | flag);
+    k_sem_give(&ack_sem);
+}
 
-    char *fields[MAX_FIELDS] = {0};
-    char *p = buf;
-    int idx = 0;
+/**
+ * @brief Routes one received byte to the NMEA or the binary decoder.
+ *
+ * @param c Received byte.
+ */
+static void gps_process_byte(uint8_t c)
+{
+    if (!bin_mode) {
+        nmea_process_byte(&parser, c);
+        return;
+    }
 
-    fields[idx++] = p;
-    while (*p && idx < MAX_FIELDS) {
-        if (*p == ',') {
-            *p = '\0';
-            fields[idx++] = p + 1;
-        }
-        p++;
-    }
-
-    /* Expected GGA field layout:
-     *  0 = $GPGGA or $GNGGA
-     *  1 = UTC time (hhmmss.ss)
-     *  2 = Latitude (DDMM.MMMM)
-     *  3 = N/S
-     *  4 = Longitude (DDDMM.MMMM)
-     *  5 = E/W
-     *  6 = Fix quality
-     *  7 = Number of satellites
-     *  8 = HDOP
-     *  9 = Altitude (meters)
-     */
-    if (!fields[0] || !strstr(fields[0], "GGA")) return false;
-    if (!fields[2] || !fields[3] || !fields[4] || !fields[5]) return false;
-
-    out->lat = nmea_to_degrees(fields[2], fields[3][0]);
-    out->lon = nmea_to_degrees(fields[4], fields[5][0]);
-    out->alt = fields[9] ? (float)atof(fields[9]) : 0.0f;
-    out->sats = fields[7] ? atoi(fields[7]) : 0;
-    out->hdop = fields[8] ? (float)atof(fields[8]) : 0.0f;
-
-    if (fields[1]) {
-        strncpy(out->utc_time, fields[1], sizeof(out->utc_time) - 1);
-        out->utc_time[sizeof(out->utc_time) - 1] = '\0';
-    } else {
-        out->utc_time[0] = '\0';
+    if (mtk_bin_process_byte(&bin_parser, c) &&
+        bin_parser.cmd == MTK_BIN_CMD_ACK && bin_parser.payload_len >= 3) {
+        uint16_t seq = (uint16_t)(bin_parser.payload[0] | (bin_parser.payload[1] << 8));
+        atomic_set(&epo_ack, ((atomic_val_t)seq << 8) | bin_parser.payload[2]);
+        k_sem_give(&epo_ack_sem);
     }
+}
 
-    return true;
+/**
+ * @brief Pushes received bytes into the parser ring buffer.
+ *
+ * Called from interrupt context only. Bytes that do not fit are dropped
+ * and accounted in @ref rx_overruns.
+ *
+ * @param data Pointer to the received bytes.
+ * @param len Number of received bytes.
+ */
+static void gps_rx_push(const uint8_t *data, size_t len)
+{
+    uint32_t written = ring_buf_put(&rx_ring, data, len);
+    if (written < len) {
+        atomic_add(&rx_overruns, (atomic_val_t)(len - written));
+    }
 }
 
 /**
  * @brief UART interrupt handler for GPS data reception.
  *
- * Reads incoming bytes from the UART FIFO, reconstructs complete NMEA
- * sentences, and triggers parsing for GGA or GNGGA messages. Upon successful
- * parsing, the global GPS data structure is updated and a semaphore is given
- * to signal waiting threads.
+ * Reads incoming bytes from the UART FIFO one at a time and pushes them
+ * into the ring buffer. The parser thread is woken up once per line.
+ * Used in @ref GPS_RX_MODE_IRQ.
  *
  * @param dev Pointer to the UART device generating the interrupt.
  * @param user_data Optional user data pointer (unused).
@@ -157,42 +195,173 @@ static void uart_isr(const struct device *dev, void *user_data)
 
     while (uart_irq_update(dev) && uart_irq_rx_ready(dev)) {
         if (uart_fifo_read(dev, &c, 1) == 1) {
-            if (c == '$') {
-                line_pos = 0;
-                nmea_line[line_pos++] = (char)c;
-            } else if (line_pos < (BUF_SIZE - 1)) {
-                nmea_line[line_pos++] = (char)c;
+            gps_rx_push(&c, 1);
+            if (c == '\n') {
+                k_sem_give(&rx_sem);
             }
+        } else {
+            break;
+        }
+    }
+}
 
-            if (c == '\n') {
-                nmea_line[line_pos] = '\0';
+/**
+ * @brief UART asynchronous API event handler for GPS data reception.
+ *
+ * Used in @ref GPS_RX_MODE_ASYNC. The DMA channel fills one of two buffers
+ * while the other is being handed back to the driver, so the CPU is only
+ * interrupted when a buffer is full or the line goes idle:
+ *  - @c UART_RX_RDY: new bytes are pushed into the ring buffer for the parser.
+ *  - @c UART_RX_BUF_REQUEST: the driver asks for the next buffer.
+ *  - @c UART_RX_DISABLED: reception stopped (e.g. after an error) and is restarted.
+ *
+ * @param dev Pointer to the UART device generating the event.
+ * @param evt Pointer to the UART event descriptor.
+ * @param user_data Optional user data pointer (unused).
+ */
+static void uart_async_cb(const struct device *dev, struct uart_event *evt, void *user_data)
+{
+    switch (evt->type) {
+    case UART_RX_RDY:
+        gps_rx_push(&evt->data.rx.buf[evt->data.rx.offset], evt->data.rx.len);
+        k_sem_give(&rx_sem);
+        break;
 
-                if (strstr(nmea_line, "$GPGGA") || strstr(nmea_line, "$GNGGA")) {
-                    gps_data_t tmp;
-                    if (parse_gga(nmea_line, &tmp)) {
-                        memcpy(&parsed_data, &tmp, sizeof(gps_data_t));
-                        k_sem_give(&parsed_sem);
-                    }
-                }
+    case UART_RX_BUF_REQUEST:
+        uart_rx_buf_rsp(dev, rx_dma_buf[rx_dma_next], GPS_DMA_BUF_SIZE);
+        rx_dma_next ^= 1;
+        break;
 
-                line_pos = 0;
-            }
-        } else {
+    case UART_RX_STOPPED:
+        printk("[GPS] - UART RX stopped (reason %d)\n", evt->data.rx_stop.reason);
+        break;
+
+    case UART_RX_DISABLED:
+        if (rx_paused) {
+            k_sem_give(&rx_stopped_sem);
             break;
         }
+        rx_dma_next = 1;
+        uart_rx_enable(dev, rx_dma_buf[0], GPS_DMA_BUF_SIZE, GPS_RX_TIMEOUT_US);
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief NMEA parser thread entry function.
+ *
+ * Sleeps until the reception path signals new data, then drains the ring
+ * buffer in small chunks and runs the streaming NMEA parser.
+ *
+ * @param arg1 Unused (set to NULL).
+ * @param arg2 Unused (set to NULL).
+ * @param arg3 Unused (set to NULL).
+ */
+static void gps_parser_fn(void *arg1, void *arg2, void *arg3)
+{
+    uint8_t chunk[GPS_PARSE_CHUNK];
+    uint32_t len;
+
+    while (1) {
+        k_sem_take(&rx_sem, K_FOREVER);
+
+        while ((len = ring_buf_get(&rx_ring, chunk, sizeof(chunk))) > 0) {
+            for (uint32_t i = 0; i < len; i++) {
+                gps_process_byte(chunk[i]);
+            }
+        }
+
+        atomic_val_t dropped = atomic_clear(&rx_overruns);
+        if (dropped > 0) {
+            printk("[GPS] - RX ring buffer overrun, %ld bytes dropped\n", (long)dropped);
+        }
+    }
+}
+
+/**
+ * @brief Starts asynchronous DMA reception on the GPS UART.
+ *
+ * @param dev Pointer to the UART device.
+ * @retval 0 If reception was enabled.
+ * @retval Negative error code from the UART asynchronous API on failure.
+ */
+static int gps_rx_async_start(const struct device *dev)
+{
+    int ret = uart_callback_set(dev, uart_async_cb, NULL);
+    if (ret < 0) {
+        printk("[GPS] - UART async API not supported (%d)\n", ret);
+        return ret;
     }
+
+    rx_dma_next = 1;
+    ret = uart_rx_enable(dev, rx_dma_buf[0], GPS_DMA_BUF_SIZE, GPS_RX_TIMEOUT_US);
+    if (ret < 0) {
+        printk("[GPS] - Failed to enable DMA reception (%d)\n", ret);
+        return ret;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Starts reception in the mode selected at initialization.
+ *
+ * @retval 0 If reception was enabled.
+ * @retval Negative error code if DMA reception could not be started.
+ */
+static int gps_rx_start(void)
+{
+    rx_paused = false;
+
+    if (rx_mode == GPS_RX_MODE_ASYNC) {
+        return gps_rx_async_start(uart_dev);
+    }
+
+    uart_irq_callback_set(uart_dev, uart_isr);
+    uart_irq_rx_enable(uart_dev);
+    return 0;
+}
+
+/**
+ * @brief Stops reception, e.g. before reconfiguring the UART.
+ *
+ * In asynchronous mode, waits until the driver reports that DMA reception
+ * has been disabled so that no buffer is in use any more.
+ *
+ * @retval 0 If reception was stopped.
+ * @retval -ETIMEDOUT If the driver did not report the end of DMA reception.
+ */
+static int gps_rx_stop(void)
+{
+    rx_paused = true;
+
+    if (rx_mode == GPS_RX_MODE_ASYNC) {
+        k_sem_reset(&rx_stopped_sem);
+        if (uart_rx_disable(uart_dev) < 0) return 0; /* Already disabled */
+        if (k_sem_take(&rx_stopped_sem, GPS_RX_STOP_TIMEOUT) < 0) return -ETIMEDOUT;
+        return 0;
+    }
+
+    uart_irq_rx_disable(uart_dev);
+    return 0;
 }
 
 /**
- * @brief Initializes the GPS UART and enables the interrupt handler.
+ * @brief Initializes the GPS UART and enables the reception path.
  *
- * Validates the provided configuration, verifies UART readiness, sets up
- * the ISR for GPS data reception, and enables RX interrupts.
+ * Validates the provided configuration, verifies UART readiness, launches
+ * the NMEA parser thread and either
+ * sets up the ISR for GPS data reception and enables RX interrupts, or
+ * starts double-buffered DMA reception through the UART asynchronous API.
  *
  * @param cfg Pointer to the GPS configuration structure.
  * @retval 0 If initialization succeeded.
  * @retval -EINVAL If configuration is invalid.
  * @retval -ENODEV If the UART device is not ready.
+ * @retval Negative error code if DMA reception could not be started.
  */
 int gps_init(const struct gps_config *cfg)
 {
@@ -211,32 +380,535 @@ int gps_init(const struct gps_config *cfg)
     }
 
     k_sem_init(&parsed_sem, 0, 1);
-    uart_irq_callback_set(uart_dev, uart_isr);
-    uart_irq_rx_enable(uart_dev);
+    k_sem_init(&rx_sem, 0, 1);
+    k_sem_init(&rx_stopped_sem, 0, 1);
+    k_sem_init(&ack_sem, 0, 1);
+    k_sem_init(&epo_ack_sem, 0, 1);
+    nmea_parser_init(&parser, gps_publish_fix, gps_pmtk_ack, NULL);
+
+    k_thread_create(&gps_parser_data,
+                    gps_parser_stack,
+                    K_THREAD_STACK_SIZEOF(gps_parser_stack),
+                    gps_parser_fn,
+                    NULL, NULL, NULL,
+                    GPS_PARSER_PRIORITY, 0, K_NO_WAIT);
+    k_thread_name_set(&gps_parser_data, "gps_parser");
+
+    rx_mode = cfg->rx_mode;
+    int ret = gps_rx_start();
+    if (ret < 0) return ret;
 
     printk("[GPS] - GPS initialized successfully\n");
     return 0;
 }
 
 /**
- * @brief Waits for the next valid GGA sentence to be parsed.
+ * @brief Copies the seqlock-protected latest epoch.
+ *
+ * Retries while the parser thread is updating the slot. If the writer was
+ * preempted mid-update, the reader sleeps one tick so a lower-priority
+ * writer can complete.
+ *
+ * @param out Pointer to store the fix.
+ * @retval 0 If a consistent copy was made.
+ * @retval -ENODATA If no epoch has been published yet.
+ * @retval -EBUSY If no consistent copy could be made.
+ */
+static int gps_read_latest(gps_data_t *out)
+{
+    for (int i = 0; i < GPS_LATEST_MAX_RETRIES; i++) {
+        atomic_val_t gen = atomic_get(&latest.gen);
+
+        if (gen == 0) return -ENODATA;
+        if (gen & 1) {
+            k_sleep(K_TICKS(1));
+            continue;
+        }
+
+        barrier_dmem_fence_full();
+        memcpy(out, &latest.data, sizeof(gps_data_t));
+        barrier_dmem_fence_full();
+
+        if (atomic_get(&latest.gen) == gen) return 0;
+    }
+
+    return -EBUSY;
+}
+
+/**
+ * @brief Returns the latest fused fix without blocking.
  *
- * Blocks until a new GGA frame is available or the specified timeout expires.
- * On success, copies the latest parsed data into the provided buffer.
+ * @param out Pointer to store the GPS data.
+ * @param max_age_ms Maximum accepted age of the fix (ms).
+ * @retval 0 If a fix no older than @p max_age_ms was copied.
+ * @retval -EINVAL If the output pointer is invalid.
+ * @retval -ENODATA If no epoch has been published yet.
+ * @retval -ESTALE If the latest fix is older than @p max_age_ms (it is still copied).
+ * @retval -EBUSY If the slot was being updated on every attempt.
+ */
+int gps_get_latest(gps_data_t *out, uint32_t max_age_ms)
+{
+    if (!out) return -EINVAL;
+
+    int ret = gps_read_latest(out);
+    if (ret < 0) return ret;
+
+    return (k_uptime_get() - out->uptime > max_age_ms) ? -ESTALE : 0;
+}
+
+/**
+ * @brief Waits for the next fused GPS epoch to be published.
+ *
+ * Blocks until a new epoch is available or the specified timeout expires.
+ * On success, copies the latest published fix into the provided buffer.
  *
  * @param out Pointer to store the parsed GPS data.
  * @param timeout Timeout duration (e.g. @c K_FOREVER, @c K_MSEC(2000), @c K_NO_WAIT).
  * @retval 0 If valid GPS data was received before timeout.
- * @retval -ETIMEDOUT If no new GGA sentence was parsed within the timeout period.
+ * @retval -EAGAIN If no new epoch was published within the timeout period.
  * @retval -EINVAL If the output pointer is invalid.
  */
-int gps_wait_for_gga(gps_data_t *out, k_timeout_t timeout)
+int gps_wait_for_fix(gps_data_t *out, k_timeout_t timeout)
 {
     if (!out) return -EINVAL;
 
     int ret = k_sem_take(&parsed_sem, timeout);
     if (ret < 0) return ret;
 
-    memcpy(out, &parsed_data, sizeof(gps_data_t));
+    return gps_read_latest(out);
+}
+
+/**
+ * @brief Sends an NMEA/PMTK sentence to the GPS module.
+ *
+ * Frames @p body as "$<body>*hh\r\n", computing the XOR checksum, and
+ * transmits it with polled output.
+ *
+ * @param body Sentence body without '$', checksum and line terminator.
+ */
+static void gps_send_sentence(const char *body)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    uint8_t checksum = 0;
+
+    uart_poll_out(uart_dev, '$');
+    for (const char *c = body; *c; c++) {
+        checksum ^= (uint8_t)*c;
+        uart_poll_out(uart_dev, (unsigned char)*c);
+    }
+    uart_poll_out(uart_dev, '*');
+    uart_poll_out(uart_dev, hex[checksum >> 4]);
+    uart_poll_out(uart_dev, hex[checksum & 0x0F]);
+    uart_poll_out(uart_dev, '\r');
+    uart_poll_out(uart_dev, '\n');
+}
+
+/**
+ * @brief Sends a PMTK command and waits for its acknowledgement.
+ *
+ * @param body Command body without '$' and checksum (e.g. "PMTK220,1000").
+ * @param timeout Maximum time to wait for the matching PMTK001 acknowledgement.
+ * @retval 0 If the module acknowledged the command successfully.
+ * @retval -EINVAL If @p body is not a PMTK command or the module rejected it as invalid.
+ * @retval -ENOTSUP If the module does not support the command.
+ * @retval -EIO If the command was valid but the action failed.
+ * @retval -ETIMEDOUT If no acknowledgement was received in time.
+ */
+int gps_pmtk_command(const char *body, k_timeout_t timeout)
+{
+    int32_t cmd = 0;
+
+    if (!uart_dev || !body || strncmp(body, "PMTK", 4) != 0) return -EINVAL;
+
+    for (const char *c = body + 4; *c >= '0' && *c <= '9'; c++) {
+        cmd = cmd * 10 + (*c - '0');
+    }
+
+    k_mutex_lock(&pmtk_lock, K_FOREVER);
+
+    k_sem_reset(&ack_sem);
+    gps_send_sentence(body);
+
+    int ret = -ETIMEDOUT;
+    k_timepoint_t end = sys_timepoint_calc(timeout);
+
+    while (k_sem_take(&ack_sem, sys_timepoint_timeout(end)) == 0) {
+        atomic_val_t ack = atomic_get(&pmtk_ack);
+        if ((ack >> 8) != cmd) continue;
+
+        switch (ack & 0xFF) {
+        case PMTK_ACK_SUCCESS:     ret = 0;        break;
+        case PMTK_ACK_UNSUPPORTED: ret = -ENOTSUP; break;
+        case PMTK_ACK_FAILED:      ret = -EIO;     break;
+        default:                   ret = -EINVAL;  break;
+        }
+        break;
+    }
+
+    k_mutex_unlock(&pmtk_lock);
+    return ret;
+}
+
+/**
+ * @brief Reconfigures the UART to a new baud rate.
+ *
+ * Reception is stopped during the change so no DMA buffer is in flight.
+ *
+ * @param uart_cfg Current UART configuration, updated with @p baudrate.
+ * @param baudrate New baud rate.
+ * @retval 0 If the UART runs at @p baudrate.
+ * @retval Negative error code from the UART API on failure.
+ */
+static int gps_uart_set_baudrate(struct uart_config *uart_cfg, uint32_t baudrate)
+{
+    int ret = gps_rx_stop();
+    if (ret == 0) {
+        uart_cfg->baudrate = baudrate;
+        ret = uart_configure(uart_dev, uart_cfg);
+    }
+    int start_ret = gps_rx_start();
+
+    return (ret < 0) ? ret : start_ret;
+}
+
+/**
+ * @brief Switches the GPS module and the UART to a new baud rate.
+ *
+ * Sends PMTK251 at the current rate (the module does not acknowledge it),
+ * waits for the command to leave the wire, then reconfigures the UART.
+ * The new link is checked with PMTK000 (retried once, as the first bytes
+ * after the switch may be garbled). If the module does not answer, it
+ * missed or rejected PMTK251, so the UART is returned to the previous rate
+ * to keep the link usable.
+ *
+ * @param baudrate New baud rate.
+ * @retval 0 If the module and the UART run at @p baudrate.
+ * @retval Negative error code from the UART API or @ref gps_pmtk_command()
+ *         on failure; the previous baud rate is then restored.
+ */
+static int gps_set_baudrate(uint32_t baudrate)
+{
+    struct uart_config uart_cfg;
+    char cmd[24];
+
+    int ret = uart_config_get(uart_dev, &uart_cfg);
+    if (ret < 0) return ret;
+    if (uart_cfg.baudrate == baudrate) return 0;
+
+    uint32_t old_baudrate = uart_cfg.baudrate;
+
+    snprintk(cmd, sizeof(cmd), "PMTK251,%u", baudrate);
+
+    k_mutex_lock(&pmtk_lock, K_FOREVER);
+    gps_send_sentence(cmd);
+    k_sleep(GPS_BAUD_SWITCH_DELAY);
+
+    ret = gps_uart_set_baudrate(&uart_cfg, baudrate);
+    if (ret == 0) {
+        /* pmtk_lock is recursive, so the check cannot be interleaved */
+        ret = gps_pmtk_command("PMTK000", GPS_PMTK_ACK_TIMEOUT);
+        if (ret < 0) {
+            ret = gps_pmtk_command("PMTK000", GPS_PMTK_ACK_TIMEOUT);
+        }
+    }
+
+    if (ret < 0) {
+        printk("[GPS] - No answer at %u baud (%d), back to %u\n", baudrate, ret, old_baudrate);
+        int restore_ret = gps_uart_set_baudrate(&uart_cfg, old_baudrate);
+        if (restore_ret < 0) {
+            printk("[GPS] - Failed to restore baud rate %u (%d)\n", old_baudrate, restore_ret);
+        }
+    }
+    k_mutex_unlock(&pmtk_lock);
+
+    return ret;
+}
+
+/**
+ * @brief Configures the GPS module output and update rate.
+ *
+ * Applies, in order, the baud rate (PMTK251), the NMEA sentence filter
+ * (PMTK314) and the fix interval (PMTK220). The baud rate is changed first
+ * so the other commands and their acknowledgements already use the faster
+ * link. Once the sentence filter is accepted, the parser publishes an epoch
+ * as soon as all enabled sentences have been received.
+ *
+ * @param cfg Pointer to the GPS configuration structure.
+ * @retval 0 If all requested settings were applied.
+ * @retval -EINVAL If the configuration is invalid or the driver is not initialized.
+ * @retval Negative error code from @ref gps_pmtk_command() or the UART API on failure.
+ */
+int gps_configure(const struct gps_config *cfg)
+{
+    char cmd[GPS_PMTK_MAX_LEN];
+    int ret;
+
+    if (!cfg || !uart_dev) return -EINVAL;
+
+    if (cfg->baudrate) {
+        ret = gps_set_baudrate(cfg->baudrate);
+        if (ret < 0) {
+            printk("[GPS] - Failed to set baud rate %u (%d)\n", cfg->baudrate, ret);
+            return ret;
+        }
+    }
+
+    if (cfg->sentences & GPS_SENTENCE_ALL) {
+        /* GLL, RMC, VTG, GGA, GSA, GSV, 12 reserved fields, MCHN */
+        snprintk(cmd, sizeof(cmd), "PMTK314,0,%d,%d,%d,%d,0,0,0,0,0,0,0,0,0,0,0,0,0,0",
+                 (cfg->sentences & GPS_SENTENCE_RMC) ? 1 : 0,
+                 (cfg->sentences & GPS_SENTENCE_VTG) ? 1 : 0,
+                 (cfg->sentences & GPS_SENTENCE_GGA) ? 1 : 0,
+                 (cfg->sentences & GPS_SENTENCE_GSA) ? 1 : 0);
+        ret = gps_pmtk_command(cmd, GPS_PMTK_ACK_TIMEOUT);
+        if (ret < 0) {
+            printk("[GPS] - Sentence filter rejected (%d)\n", ret);
+            return ret;
+        }
+        nmea_set_expected(&parser, cfg->sentences);
+    }
+
+    if (cfg->fix_interval_ms) {
+        snprintk(cmd, sizeof(cmd), "PMTK220,%u", cfg->fix_interval_ms);
+        ret = gps_pmtk_command(cmd, GPS_PMTK_ACK_TIMEOUT);
+        if (ret < 0) {
+            printk("[GPS] - Fix interval rejected (%d)\n", ret);
+            return ret;
+        }
+    }
+
+    printk("[GPS] - GPS configured (baud %u, fix interval %u ms, sentences 0x%02X)\n",
+           cfg->baudrate, cfg->fix_interval_ms, cfg->sentences);
     return 0;
 }
+
+/**
+ * @brief Puts the GPS module into standby mode (PMTK161).
+ *
+ * The receiver stops tracking and NMEA output until it is woken up with
+ * @ref gps_wakeup(); ephemeris and time are kept for a hot start.
+ *
+ * @retval 0 If the module acknowledged the standby request.
+ * @retval Negative error code from @ref gps_pmtk_command() on failure.
+ */
+int gps_standby(void)
+{
+    return gps_pmtk_command("PMTK161,0", GPS_PMTK_ACK_TIMEOUT);
+}
+
+/**
+ * @brief Wakes the GPS module up from standby mode.
+ *
+ * Any byte on the RX line wakes the module; PMTK000 (test command) is used
+ * so the wake-up can be confirmed by its acknowledgement. The first bytes
+ * may be lost while the module wakes, so the command is retried once.
+ *
+ * @retval 0 If the module acknowledged the wake-up.
+ * @retval Negative error code from @ref gps_pmtk_command() on failure.
+ */
+int gps_wakeup(void)
+{
+    int ret = gps_pmtk_command("PMTK000", GPS_PMTK_ACK_TIMEOUT);
+    if (ret < 0) {
+        ret = gps_pmtk_command("PMTK000", GPS_PMTK_ACK_TIMEOUT);
+    }
+    return ret;
+}
+
+/**
+ * @brief Formats a microdegree value as a signed decimal degree string.
+ *
+ * Integer-only formatting (e.g. -3703790 -> "-3.703790").
+ *
+ * @param buf Output buffer.
+ * @param size Size of @p buf.
+ * @param udeg Angle in microdegrees.
+ */
+static void format_udeg(char *buf, size_t size, int32_t udeg)
+{
+    uint32_t abs_udeg = (udeg < 0) ? (uint32_t)(-(int64_t)udeg) : (uint32_t)udeg;
+
+    snprintk(buf, size, "%s%u.%06u", (udeg < 0) ? "-" : "",
+             abs_udeg / 1000000U, abs_udeg % 1000000U);
+}
+
+/**
+ * @brief Injects the current UTC time into the receiver (PMTK740).
+ *
+ * @param utc Current UTC date and time.
+ * @retval 0 If the module acknowledged the time.
+ * @retval -EINVAL If the date is unknown.
+ * @retval Negative error code from @ref gps_pmtk_command() on failure.
+ */
+int gps_aid_time(const struct gps_utc *utc)
+{
+    char cmd[GPS_PMTK_MAX_LEN];
+
+    if (!utc || utc->year == 0) return -EINVAL;
+
+    snprintk(cmd, sizeof(cmd), "PMTK740,%04u,%02u,%02u,%02u,%02u,%02u",
+             utc->year, utc->month, utc->day, utc->hour, utc->minute, utc->second);
+    return gps_pmtk_command(cmd, GPS_PMTK_ACK_TIMEOUT);
+}
+
+/**
+ * @brief Injects a reference position and the current UTC time (PMTK741).
+ *
+ * @param lat Latitude in microdegrees.
+ * @param lon Longitude in microdegrees.
+ * @param alt Altitude in centimetres.
+ * @param utc Current UTC date and time.
+ * @retval 0 If the module acknowledged the position.
+ * @retval -EINVAL If the date is unknown.
+ * @retval Negative error code from @ref gps_pmtk_command() on failure.
+ */
+int gps_aid_position(int32_t lat, int32_t lon, int32_t alt, const struct gps_utc *utc)
+{
+    char cmd[GPS_PMTK_MAX_LEN];
+    char lat_str[16];
+    char lon_str[16];
+
+    if (!utc || utc->year == 0) return -EINVAL;
+
+    format_udeg(lat_str, sizeof(lat_str), lat);
+    format_udeg(lon_str, sizeof(lon_str), lon);
+    snprintk(cmd, sizeof(cmd), "PMTK741,%s,%s,%d,%04u,%02u,%02u,%02u,%02u,%02u",
+             lat_str, lon_str, alt / 100,
+             utc->year, utc->month, utc->day, utc->hour, utc->minute, utc->second);
+    return gps_pmtk_command(cmd, GPS_PMTK_ACK_TIMEOUT);
+}
+
+/* --- EPO upload ------------------------------------------------------------- */
+
+#if FIXED_PARTITION_EXISTS(GPS_EPO_PARTITION)
+
+/**
+ * @brief EPO image reader (@ref mtk_epo_io::read).
+ */
+static int gps_epo_read(void *ctx, size_t offset, uint8_t *buf, size_t len)
+{
+    return flash_area_read((const struct flash_area *)ctx, (off_t)offset, buf, len);
+}
+
+/**
+ * @brief Binary packet transmitter (@ref mtk_epo_io::write).
+ */
+static int gps_epo_write(void *ctx, const uint8_t *buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        uart_poll_out(uart_dev, buf[i]);
+    }
+    return 0;
+}
+
+/**
+ * @brief Waits for the next EPO acknowledgement (@ref mtk_epo_io::wait_ack).
+ */
+static int gps_epo_wait_ack(void *ctx, uint16_t *seq, uint8_t *result)
+{
+    if (k_sem_take(&epo_ack_sem, GPS_EPO_ACK_TIMEOUT) < 0) return -ETIMEDOUT;
+
+    atomic_val_t ack = atomic_get(&epo_ack);
+    *seq = (uint16_t)(ack >> 8);
+    *result = (uint8_t)(ack & 0xFF);
+    return 0;
+}
+
+/**
+ * @brief Computes the length of the EPO image stored in the partition.
+ *
+ * The image is made of 6-hour segments; the first erased segment (or the
+ * end of the partition) ends it.
+ *
+ * @param fa Pointer to the opened EPO partition.
+ * @return Image length in bytes, 0 if the partition is empty.
+ */
+static size_t gps_epo_image_len(const struct flash_area *fa)
+{
+    static const uint8_t erased[4] = { 0xFF, 0xFF, 0xFF, 0xFF };
+    uint8_t head[4];
+    size_t len = 0;
+
+    while (len + MTK_EPO_SEGMENT_SIZE <= fa->fa_size) {
+        if (flash_area_read(fa, (off_t)len, head, sizeof(head)) < 0 ||
+            memcmp(head, erased, sizeof(head)) == 0) {
+            break;
+        }
+        len += MTK_EPO_SEGMENT_SIZE;
+    }
+
+    return len;
+}
+
+/**
+ * @brief Uploads the EPO image stored in flash to the GPS module.
+ *
+ * Switches the module to binary mode (PMTK253), streams the image with
+ * @ref mtk_epo_upload() and switches back to NMEA output. PMTK commands
+ * are blocked for the duration of the transfer.
+ *
+ * @retval 0 If the whole image was acknowledged.
+ * @retval -EINVAL If @ref gps_init() was not called.
+ * @retval -ENODATA If the partition holds no EPO image.
+ * @retval Negative error code from the flash driver or @ref mtk_epo_upload().
+ */
+int gps_epo_load(void)
+{
+    const struct flash_area *fa;
+    uint8_t packet[MTK_BIN_OVERHEAD + 5];
+    /* Back to NMEA output (mode 0), keeping the current baud rate (0) */
+    static const uint8_t nmea_mode[5] = { 0, 0, 0, 0, 0 };
+
+    if (!uart_dev) return -EINVAL;
+
+    int ret = flash_area_open(FIXED_PARTITION_ID(GPS_EPO_PARTITION), &fa);
+    if (ret < 0) return ret;
+
+    size_t len = gps_epo_image_len(fa);
+    if (len == 0) {
+        flash_area_close(fa);
+        return -ENODATA;
+    }
+
+    const struct mtk_epo_io io = {
+        .read = gps_epo_read,
+        .write = gps_epo_write,
+        .wait_ack = gps_epo_wait_ack,
+        .ctx = (void *)fa,
+    };
+
+    k_mutex_lock(&pmtk_lock, K_FOREVER);
+
+    mtk_bin_parser_reset(&bin_parser);
+    k_sem_reset(&epo_ack_sem);
+    bin_mode = true;
+    gps_send_sentence("PMTK253,1,0");
+    k_sleep(GPS_EPO_MODE_DELAY);
+
+    ret = mtk_epo_upload(&io, len);
+
+    size_t n = mtk_bin_encode(packet, sizeof(packet), MTK_BIN_CMD_SET_FORMAT,
+                              nmea_mode, sizeof(nmea_mode));
+    gps_epo_write(NULL, packet, n);
+    k_sleep(GPS_EPO_MODE_DELAY);
+    bin_mode = false;
+
+    k_mutex_unlock(&pmtk_lock);
+    flash_area_close(fa);
+
+    if (ret < 0) {
+        printk("[GPS] - EPO upload failed (%d)\n", ret);
+    } else {
+        printk("[GPS] - EPO image uploaded (%u bytes)\n", (unsigned int)len);
+    }
+    return ret;
+}
+
+#else
+
+int gps_epo_load(void)
+{
+    return -ENOTSUP;
+}
+
+#endif /* FIXED_PARTITION_EXISTS(GPS_EPO_PARTITION) */
@@ -1,16 +1,23 @@
 /**
  * @file gps.h
- * @brief GPS interface for UART-based NMEA parsing (GGA sentence support).
+ * @brief GPS interface for UART-based NMEA parsing (GGA, RMC, GSA and VTG support).
  *
- * This module provides a simple GPS helper for parsing NMEA GGA sentences
- * received through a UART interface. It includes initialization, interrupt
- * setup, and a blocking wait API to obtain the most recent parsed position.
+ * This module provides a simple GPS helper for parsing NMEA sentences
+ * received through a UART interface. GGA, RMC, GSA and VTG sentences of the
+ * same NMEA epoch are fused into a single fix. It includes initialization,
+ * interrupt or DMA-based reception setup, and a blocking wait API to obtain
+ * the most recent fused fix.
  *
  * Functions:
- *  - @ref gps_init() to initialize the UART and enable ISR-based reception.
- *  - @ref gps_wait_for_gga() to wait for a parsed GGA sentence.
+ *  - @ref gps_init() to initialize the UART and enable ISR or DMA reception.
+ *  - @ref gps_configure() to trim the receiver output and raise its update/baud rate.
+ *  - @ref gps_standby() / @ref gps_wakeup() for receiver power control.
+ *  - @ref gps_aid_time() / @ref gps_aid_position() for warm-start aiding.
+ *  - @ref gps_epo_load() to upload EPO orbit predictions stored in flash.
+ *  - @ref gps_wait_for_fix() to wait for the next fused fix.
+ *  - @ref gps_get_latest() to read the newest fused fix without blocking.
  *
- * Parsed data is returned as floating-point values in a @ref gps_data_t structure.
+ * Parsed data is returned as fixed-point integers in a @ref gps_data_t structure.
  */
 
 #ifndef GPS_H_
@@ -20,58 +27,174 @@
 #include <zephyr/kernel.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include "nmea.h"
+
+/**
+ * @brief UART reception mode used by the GPS driver.
+ */
+enum gps_rx_mode {
+    GPS_RX_MODE_IRQ = 0, /**< Interrupt-driven reception, one interrupt per received byte. */
+    GPS_RX_MODE_ASYNC,   /**< Asynchronous DMA reception, one event per filled (or idle) buffer. */
+};
 
 /**
  * @brief GPS configuration structure.
  *
- * Holds the device reference used for GPS communication.
+ * Holds the device reference used for GPS communication, the selected
+ * reception mode and the receiver settings applied by @ref gps_configure().
  * The UART device must be resolved and provided by the caller.
  */
 struct gps_config {
-    const struct device *dev; /**< UART device instance used by the GPS module. */
+    const struct device *dev;  /**< UART device instance used by the GPS module. */
+    enum gps_rx_mode rx_mode;  /**< Reception mode (@ref GPS_RX_MODE_IRQ by default). */
+    uint32_t baudrate;         /**< Link baud rate set with PMTK251, 0 to keep the current one. */
+    uint16_t fix_interval_ms;  /**< Fix interval set with PMTK220 (100-10000 ms), 0 to keep the default. */
+    uint8_t sentences;         /**< GPS_SENTENCE_* mask enabled with PMTK314, 0 to keep the default output. */
 };
 
 /**
- * @brief Parsed GPS data from a GGA sentence.
+ * @brief Initializes the GPS module UART and reception path.
+ *
+ * Configures the UART device for receiving NMEA data from the GPS module.
+ * Depending on @ref gps_config::rx_mode, incoming bytes are either handled
+ * by a per-byte interrupt service routine or received through double-buffered
+ * DMA with the UART asynchronous API.
  *
- * Contains geographic and fix-related data parsed from an NMEA GGA message.
- * All numeric fields are expressed as floats for simplicity.
+ * @param cfg Pointer to the GPS configuration structure.
+ * @retval 0 If initialization was successful.
+ * @retval Negative error code if UART configuration or reception setup failed.
  */
-typedef struct {
-    float lat;           /**< Latitude in decimal degrees. */
-    float lon;           /**< Longitude in decimal degrees. */
-    float alt;           /**< Altitude in meters above mean sea level. */
-    int   sats;          /**< Number of satellites currently in use. */
-    float hdop;          /**< Horizontal dilution of precision. */
-    char  utc_time[16];  /**< UTC time (hhmmss.ss), null-terminated if available. */
-} gps_data_t;
+int gps_init(const struct gps_config *cfg);
 
 /**
- * @brief Initializes the GPS module UART and interrupt service routine.
+ * @brief Configures the GPS receiver with PMTK commands.
  *
- * Configures the UART device for receiving NMEA data from the GPS module
- * and sets up an interrupt-based handler to process incoming bytes.
+ * Switches the module and the UART to @ref gps_config::baudrate (PMTK251),
+ * restricts the NMEA output to @ref gps_config::sentences (PMTK314) and sets
+ * the fix interval (PMTK220). The new baud rate is checked with PMTK000 and
+ * the UART returns to the previous rate if the module does not answer. Each
+ * PMTK314/PMTK220 command is checked against its PMTK001 acknowledgement.
+ * Zero-valued settings are skipped.
  *
  * @param cfg Pointer to the GPS configuration structure.
- * @retval 0 If initialization was successful.
- * @retval Negative error code if UART configuration or ISR setup failed.
+ * @retval 0 If all requested settings were applied.
+ * @retval -EINVAL If the configuration is invalid or @ref gps_init() was not called.
+ * @retval -ETIMEDOUT If the module did not acknowledge a command.
+ * @retval Negative error code if the module rejected a command or the UART could not be reconfigured.
  */
-int gps_init(const struct gps_config *cfg);
+int gps_configure(const struct gps_config *cfg);
+
+/**
+ * @brief Sends a PMTK command and waits for its acknowledgement.
+ *
+ * The checksum and framing are added by the driver.
+ *
+ * @param body Command body without '$' and checksum (e.g. "PMTK220,1000").
+ * @param timeout Maximum time to wait for the matching PMTK001 acknowledgement.
+ * @retval 0 If the module acknowledged the command successfully.
+ * @retval -EINVAL If @p body is not a PMTK command or the module rejected it as invalid.
+ * @retval -ENOTSUP If the module does not support the command.
+ * @retval -EIO If the command was valid but the action failed.
+ * @retval -ETIMEDOUT If no acknowledgement was received in time.
+ */
+int gps_pmtk_command(const char *body, k_timeout_t timeout);
+
+/**
+ * @brief Puts the GPS module into standby mode (PMTK161).
+ *
+ * Tracking and NMEA output stop until @ref gps_wakeup() is called, while
+ * ephemeris and time are kept so the next fix is a hot start.
+ *
+ * @retval 0 If the module acknowledged the standby request.
+ * @retval Negative error code if the command was not acknowledged.
+ */
+int gps_standby(void);
+
+/**
+ * @brief Wakes the GPS module up from standby mode.
+ *
+ * @retval 0 If the module acknowledged the wake-up.
+ * @retval Negative error code if the module did not answer.
+ */
+int gps_wakeup(void);
+
+/**
+ * @brief Injects the current UTC time into the receiver (PMTK740).
+ *
+ * Knowing the time lets the receiver predict visible satellites from the
+ * almanac/ephemeris kept in its backup RAM.
+ *
+ * @param utc Current UTC date and time.
+ * @retval 0 If the module acknowledged the time.
+ * @retval -EINVAL If the date is unknown.
+ * @retval Negative error code if the command was not acknowledged.
+ */
+int gps_aid_time(const struct gps_utc *utc);
+
+/**
+ * @brief Injects a reference position and the current UTC time (PMTK741).
+ *
+ * Together with valid ephemeris, position and time aiding turn the next
+ * start into a warm or hot start.
+ *
+ * @param lat Latitude in microdegrees.
+ * @param lon Longitude in microdegrees.
+ * @param alt Altitude in centimetres.
+ * @param utc Current UTC date and time.
+ * @retval 0 If the module acknowledged the position.
+ * @retval -EINVAL If the date is unknown.
+ * @retval Negative error code if the command was not acknowledged.
+ */
+int gps_aid_position(int32_t lat, int32_t lon, int32_t alt, const struct gps_utc *utc);
+
+/**
+ * @brief Uploads the EPO orbit prediction image stored in flash.
+ *
+ * Streams the image from the @c epo_partition fixed partition to the module
+ * with the PMTK binary protocol (one acknowledged 191-byte packet per three
+ * satellite records), then returns the module to NMEA output. Valid EPO
+ * data lets the receiver fix within seconds without downloading ephemeris.
+ *
+ * @retval 0 If the whole image was acknowledged.
+ * @retval -ENOTSUP If the devicetree has no @c epo_partition.
+ * @retval -ENODATA If the partition holds no EPO image.
+ * @retval -ETIMEDOUT If the module stopped acknowledging packets.
+ * @retval Negative error code on other failures.
+ */
+int gps_epo_load(void);
 
 /**
- * @brief Waits for the next parsed GGA sentence.
+ * @brief Waits for the next fused GPS fix.
  *
- * Blocks until a new, valid GGA sentence has been parsed or until
- * the specified timeout expires. On success, the parsed data is
- * written into the provided @ref gps_data_t structure.
+ * Blocks until a new NMEA epoch has been fused and published or until
+ * the specified timeout expires. On success, the fused fix is written
+ * into the provided @ref gps_data_t structure.
  *
- * @param out Pointer to store the parsed GPS data.
+ * @param out Pointer to store the fused GPS data.
  * @param timeout Timeout duration (e.g. @c K_FOREVER, @c K_MSEC(2000), @c K_NO_WAIT).
- * @retval 0 If a valid GGA sentence was received and parsed successfully.
- * @retval -ETIMEDOUT If no valid GGA sentence was received before timeout.
+ * @retval 0 If a new epoch was published.
+ * @retval -EAGAIN If no new epoch was published before timeout.
+ * @retval -EINVAL If the output pointer is invalid.
  *
  * @note This function is typically used after calling @ref gps_init().
  */
-int gps_wait_for_gga(gps_data_t *out, k_timeout_t timeout);
+int gps_wait_for_fix(gps_data_t *out, k_timeout_t timeout);
+
+/**
+ * @brief Returns the latest fused GPS fix without blocking.
+ *
+ * The last published epoch is kept in a seqlock-protected slot, so the
+ * newest fix is available immediately instead of waiting for the next
+ * epoch. @ref gps_data_t::seq tells whether it was already consumed.
+ *
+ * @param out Pointer to store the fused GPS data.
+ * @param max_age_ms Maximum accepted age of the fix in milliseconds.
+ * @retval 0 If a fix no older than @p max_age_ms was copied.
+ * @retval -EINVAL If the output pointer is invalid.
+ * @retval -ENODATA If no epoch has been published yet.
+ * @retval -ESTALE If the latest fix is older than @p max_age_ms (it is still copied to @p out).
+ * @retval -EBUSY If the fix was being updated on every read attempt.
+ */
+int gps_get_latest(gps_data_t *out, uint32_t max_age_ms);
 
 #endif /* GPS_H_ */
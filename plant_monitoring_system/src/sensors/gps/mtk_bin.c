@@ -0,0 +1,195 @@
+/**
+ * @file mtk_bin.c
+ * @brief MediaTek (PMTK) binary protocol framing and EPO upload.
+ *
+ * Platform-independent implementation of the binary packet framing used by
+ * MT3339-based receivers, a streaming decoder for their acknowledgements
+ * and the EPO upload sequence. The module depends on the C standard
+ * library only, so it can also be built and exercised on a host machine.
+ */
+
+#include "mtk_bin.h"
+#include <errno.h>
+#include <string.h>
+
+#define MTK_BIN_PREAMBLE1  0x04  /**< First preamble byte. */
+#define MTK_BIN_PREAMBLE2  0x24  /**< Second preamble byte. */
+#define MTK_BIN_CR         0x0D  /**< First terminator byte. */
+#define MTK_BIN_LF         0x0A  /**< Second terminator byte. */
+
+#define MTK_EPO_ACK_SUCCESS 1    /**< Acknowledgement result: packet accepted. */
+
+size_t mtk_bin_encode(uint8_t *buf, size_t size, uint16_t cmd,
+                      const uint8_t *payload, uint16_t len)
+{
+    size_t total = (size_t)len + MTK_BIN_OVERHEAD;
+    uint8_t checksum = 0;
+
+    if (size < total || total > UINT16_MAX) return 0;
+
+    buf[0] = MTK_BIN_PREAMBLE1;
+    buf[1] = MTK_BIN_PREAMBLE2;
+    buf[2] = (uint8_t)(total & 0xFF);
+    buf[3] = (uint8_t)(total >> 8);
+    buf[4] = (uint8_t)(cmd & 0xFF);
+    buf[5] = (uint8_t)(cmd >> 8);
+    if (len > 0) memcpy(&buf[6], payload, len);
+
+    for (size_t i = 2; i < 6 + (size_t)len; i++) {
+        checksum ^= buf[i];
+    }
+
+    buf[6 + len] = checksum;
+    buf[7 + len] = MTK_BIN_CR;
+    buf[8 + len] = MTK_BIN_LF;
+
+    return total;
+}
+
+void mtk_bin_parser_reset(struct mtk_bin_parser *p)
+{
+    memset(p, 0, sizeof(*p));
+    p->state = MTK_BIN_WAIT_PREAMBLE1;
+}
+
+/**
+ * @brief Decodes one byte; see @ref mtk_bin_process_byte().
+ *
+ * Packets whose payload exceeds @ref MTK_BIN_MAX_RX_PAYLOAD are dropped
+ * as soon as their header is known.
+ */
+bool mtk_bin_process_byte(struct mtk_bin_parser *p, uint8_t c)
+{
+    switch (p->state) {
+    case MTK_BIN_WAIT_PREAMBLE1:
+        if (c == MTK_BIN_PREAMBLE1) p->state = MTK_BIN_WAIT_PREAMBLE2;
+        break;
+
+    case MTK_BIN_WAIT_PREAMBLE2:
+        if (c == MTK_BIN_PREAMBLE2) {
+            p->state = MTK_BIN_HEADER;
+            p->pos = 0;
+            p->checksum = 0;
+        } else if (c != MTK_BIN_PREAMBLE1) {
+            p->state = MTK_BIN_WAIT_PREAMBLE1;
+        }
+        break;
+
+    case MTK_BIN_HEADER:
+        p->header[p->pos++] = c;
+        p->checksum ^= c;
+        if (p->pos < sizeof(p->header)) break;
+
+        p->length = (uint16_t)(p->header[0] | (p->header[1] << 8));
+        if (p->length < MTK_BIN_OVERHEAD ||
+            p->length - MTK_BIN_OVERHEAD > MTK_BIN_MAX_RX_PAYLOAD) {
+            p->state = MTK_BIN_WAIT_PREAMBLE1;
+            break;
+        }
+        p->pos = 0;
+        p->state = (p->length == MTK_BIN_OVERHEAD) ? MTK_BIN_CHECKSUM : MTK_BIN_PAYLOAD;
+        break;
+
+    case MTK_BIN_PAYLOAD:
+        p->payload[p->pos++] = c;
+        p->checksum ^= c;
+        if (p->pos == p->length - MTK_BIN_OVERHEAD) p->state = MTK_BIN_CHECKSUM;
+        break;
+
+    case MTK_BIN_CHECKSUM:
+        p->state = (c == p->checksum) ? MTK_BIN_WAIT_CR : MTK_BIN_WAIT_PREAMBLE1;
+        break;
+
+    case MTK_BIN_WAIT_CR:
+        p->state = (c == MTK_BIN_CR) ? MTK_BIN_WAIT_LF : MTK_BIN_WAIT_PREAMBLE1;
+        break;
+
+    case MTK_BIN_WAIT_LF:
+        p->state = MTK_BIN_WAIT_PREAMBLE1;
+        if (c != MTK_BIN_LF) break;
+
+        p->cmd = (uint16_t)(p->header[2] | (p->header[3] << 8));
+        p->payload_len = (uint16_t)(p->length - MTK_BIN_OVERHEAD);
+        return true;
+
+    default:
+        p->state = MTK_BIN_WAIT_PREAMBLE1;
+        break;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Sends one EPO packet and waits for its acknowledgement.
+ *
+ * Acknowledgements for other sequence numbers (late answers to a previous
+ * attempt) are skipped.
+ *
+ * @param io I/O operations.
+ * @param packet Complete binary packet.
+ * @param seq Sequence number carried by @p packet.
+ * @retval 0 If the packet was accepted.
+ * @retval Negative error code after @ref MTK_EPO_MAX_RETRIES attempts.
+ */
+static int mtk_epo_send_packet(const struct mtk_epo_io *io, const uint8_t *packet, uint16_t seq)
+{
+    int ret = -ETIMEDOUT;
+
+    for (int attempt = 0; attempt < MTK_EPO_MAX_RETRIES; attempt++) {
+        uint16_t ack_seq;
+        uint8_t result;
+
+        ret = io->write(io->ctx, packet, MTK_EPO_PACKET_SIZE);
+        if (ret < 0) return ret;
+
+        do {
+            ret = io->wait_ack(io->ctx, &ack_seq, &result);
+        } while (ret == 0 && ack_seq != seq);
+
+        if (ret == 0) {
+            if (result == MTK_EPO_ACK_SUCCESS) return 0;
+            ret = -EIO;
+        }
+    }
+
+    return ret;
+}
+
+int mtk_epo_upload(const struct mtk_epo_io *io, size_t image_len)
+{
+    uint8_t payload[MTK_EPO_PAYLOAD_SIZE];
+    uint8_t packet[MTK_EPO_PACKET_SIZE];
+    const size_t chunk = MTK_EPO_SVS_PER_PACKET * MTK_EPO_SV_SIZE;
+    uint16_t seq = 0;
+    int ret;
+
+    if (image_len == 0 || image_len % MTK_EPO_SV_SIZE != 0 ||
+        image_len / chunk >= MTK_EPO_SEQ_END) {
+        return -EINVAL;
+    }
+
+    for (size_t offset = 0; offset < image_len; offset += chunk, seq++) {
+        size_t len = (image_len - offset < chunk) ? image_len - offset : chunk;
+
+        /* Unused records of the last packet are sent as zeros */
+        memset(payload, 0, sizeof(payload));
+        payload[0] = (uint8_t)(seq & 0xFF);
+        payload[1] = (uint8_t)(seq >> 8);
+
+        ret = io->read(io->ctx, offset, &payload[2], len);
+        if (ret < 0) return ret;
+
+        mtk_bin_encode(packet, sizeof(packet), MTK_BIN_CMD_EPO_DATA, payload, sizeof(payload));
+        ret = mtk_epo_send_packet(io, packet, seq);
+        if (ret < 0) return ret;
+    }
+
+    /* End of transfer: sequence 0xFFFF with empty records */
+    memset(payload, 0, sizeof(payload));
+    payload[0] = (uint8_t)(MTK_EPO_SEQ_END & 0xFF);
+    payload[1] = (uint8_t)(MTK_EPO_SEQ_END >> 8);
+    mtk_bin_encode(packet, sizeof(packet), MTK_BIN_CMD_EPO_DATA, payload, sizeof(payload));
+
+    return mtk_epo_send_packet(io, packet, MTK_EPO_SEQ_END);
+}
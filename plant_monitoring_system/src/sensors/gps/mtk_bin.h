@@ -0,0 +1,143 @@
+/**
+ * @file mtk_bin.h
+ * @brief MediaTek (PMTK) binary protocol framing and EPO upload.
+ *
+ * MT3339-based receivers (e.g. PA1616S) accept Extended Prediction Orbit
+ * (EPO) data only in binary mode, entered with "PMTK253,1,0". This module
+ * implements the binary packet framing, a streaming decoder for the packets
+ * sent back by the receiver and the EPO upload sequence with per-packet
+ * acknowledgements. It only depends on the C standard library; the UART,
+ * the image storage and the acknowledgement wait are provided through
+ * @ref mtk_epo_io, so the upload can be driven by the GPS driver on the
+ * target or by a scripted stand-in on a host machine.
+ *
+ * Binary packet layout (little endian):
+ *
+ *   0x04 0x24 | length (2) | command (2) | payload | checksum (1) | 0x0D 0x0A
+ *
+ * where length counts the whole packet and the checksum is the XOR of the
+ * length, command and payload bytes.
+ *
+ * Functions:
+ *  - @ref mtk_bin_encode() to frame a binary packet.
+ *  - @ref mtk_bin_parser_reset() / @ref mtk_bin_process_byte() to decode received packets.
+ *  - @ref mtk_epo_upload() to stream an EPO image to the receiver.
+ */
+
+#ifndef MTK_BIN_H_
+#define MTK_BIN_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define MTK_BIN_OVERHEAD        9     /**< Preamble, length, command, checksum and terminator bytes. */
+#define MTK_BIN_MAX_RX_PAYLOAD  16    /**< Largest payload decoded from the receiver. */
+
+#define MTK_BIN_CMD_ACK         2     /**< Acknowledgement of an EPO packet. */
+#define MTK_BIN_CMD_SET_FORMAT  253   /**< Output format change (back to NMEA). */
+#define MTK_BIN_CMD_EPO_DATA    722   /**< EPO data packet. */
+
+#define MTK_EPO_SV_SIZE         60    /**< Size of one satellite record in an EPO image. */
+#define MTK_EPO_SVS_PER_PACKET  3     /**< Satellite records per EPO data packet. */
+#define MTK_EPO_SEGMENT_SIZE    (32 * MTK_EPO_SV_SIZE) /**< One 6-hour segment of GPS orbits. */
+#define MTK_EPO_PAYLOAD_SIZE    (2 + MTK_EPO_SVS_PER_PACKET * MTK_EPO_SV_SIZE) /**< Sequence + records. */
+#define MTK_EPO_PACKET_SIZE     (MTK_BIN_OVERHEAD + MTK_EPO_PAYLOAD_SIZE)      /**< 191 bytes. */
+#define MTK_EPO_SEQ_END         0xFFFF /**< Sequence number of the end-of-transfer packet. */
+#define MTK_EPO_MAX_RETRIES     3      /**< Transmissions of one packet before giving up. */
+
+/**
+ * @brief Streaming decoder states.
+ */
+enum mtk_bin_state {
+    MTK_BIN_WAIT_PREAMBLE1 = 0, /**< Waiting for 0x04. */
+    MTK_BIN_WAIT_PREAMBLE2,     /**< Waiting for 0x24. */
+    MTK_BIN_HEADER,             /**< Receiving length and command. */
+    MTK_BIN_PAYLOAD,            /**< Receiving payload bytes. */
+    MTK_BIN_CHECKSUM,           /**< Receiving the checksum. */
+    MTK_BIN_WAIT_CR,            /**< Waiting for 0x0D. */
+    MTK_BIN_WAIT_LF,            /**< Waiting for 0x0A. */
+};
+
+/**
+ * @brief Streaming decoder for binary packets sent by the receiver.
+ */
+struct mtk_bin_parser {
+    enum mtk_bin_state state;                 /**< Current decoder state. */
+    uint8_t header[4];                        /**< Length and command bytes. */
+    uint8_t payload[MTK_BIN_MAX_RX_PAYLOAD];  /**< Payload of the packet being received. */
+    uint16_t length;                          /**< Total packet length announced in the header. */
+    uint16_t pos;                             /**< Bytes received in the current state. */
+    uint8_t checksum;                         /**< Running XOR checksum. */
+
+    uint16_t cmd;                             /**< Command of the last complete packet. */
+    uint16_t payload_len;                     /**< Payload length of the last complete packet. */
+};
+
+/**
+ * @brief I/O operations used by @ref mtk_epo_upload().
+ *
+ * All callbacks return 0 on success or a negative errno value.
+ */
+struct mtk_epo_io {
+    /** Reads @p len bytes of the EPO image at @p offset. */
+    int (*read)(void *ctx, size_t offset, uint8_t *buf, size_t len);
+    /** Sends a complete binary packet to the receiver. */
+    int (*write)(void *ctx, const uint8_t *buf, size_t len);
+    /** Waits for the next EPO acknowledgement (-ETIMEDOUT if none). */
+    int (*wait_ack)(void *ctx, uint16_t *seq, uint8_t *result);
+    void *ctx; /**< Opaque pointer passed to the callbacks. */
+};
+
+/**
+ * @brief Frames a binary packet.
+ *
+ * @param buf Output buffer.
+ * @param size Size of @p buf.
+ * @param cmd Command identifier.
+ * @param payload Payload bytes (may be NULL if @p len is 0).
+ * @param len Payload length.
+ * @return Packet length, or 0 if @p buf is too small.
+ */
+size_t mtk_bin_encode(uint8_t *buf, size_t size, uint16_t cmd,
+                      const uint8_t *payload, uint16_t len);
+
+/**
+ * @brief Resets the binary packet decoder.
+ *
+ * @param p Pointer to the decoder.
+ */
+void mtk_bin_parser_reset(struct mtk_bin_parser *p);
+
+/**
+ * @brief Feeds one received byte into the binary packet decoder.
+ *
+ * @param p Pointer to the decoder.
+ * @param c Received byte.
+ * @retval true If a complete, checksum-valid packet was received; its
+ *         command and payload are in @ref mtk_bin_parser::cmd and
+ *         @ref mtk_bin_parser::payload.
+ * @retval false Otherwise.
+ */
+bool mtk_bin_process_byte(struct mtk_bin_parser *p, uint8_t c);
+
+/**
+ * @brief Streams an EPO image to a receiver in binary mode.
+ *
+ * The image is sent as numbered packets of @ref MTK_EPO_SVS_PER_PACKET
+ * satellite records. Each packet must be acknowledged with its sequence
+ * number before the next one is sent; it is retransmitted up to
+ * @ref MTK_EPO_MAX_RETRIES times otherwise. The transfer ends with the
+ * @ref MTK_EPO_SEQ_END packet.
+ *
+ * @param io I/O operations.
+ * @param image_len Image length in bytes (a multiple of @ref MTK_EPO_SV_SIZE).
+ * @retval 0 If the whole image was acknowledged.
+ * @retval -EINVAL If the image length is invalid.
+ * @retval -ETIMEDOUT If a packet was never acknowledged.
+ * @retval -EIO If the receiver rejected a packet on every attempt.
+ * @retval Negative error code returned by an I/O callback.
+ */
+int mtk_epo_upload(const struct mtk_epo_io *io, size_t image_len);
+
+#endif /* MTK_BIN_H_ */
@@ -0,0 +1,667 @@
+/**
+ * @file nmea.c
+ * @brief Streaming NMEA (GGA/RMC/GSA/VTG) and PMTK001 parser.
+ *
+ * Platform-independent parsing core of the GPS driver. Bytes are fed one at
+ * a time into a single-pass state machine that tokenizes fields in place,
+ * validates the XOR checksum incrementally and discards unsupported
+ * sentences as soon as their address field is known. A dispatch table routes
+ * GGA, RMC, GSA and VTG sentences to their parsers, which merge them into
+ * one fix per NMEA epoch. Numeric conversions use integer arithmetic only.
+ *
+ * The module depends on the C standard library only, so it can also be
+ * built and exercised on a host machine.
+ */
+
+#include "nmea.h"
+#include <string.h>
+
+#define NMEA_ADDR_LEN 5   /**< Length of the address field (talker ID + sentence ID). */
+#define PMTK_ADDR_LEN 7   /**< Length of a PMTK address field (e.g. "PMTK001"). */
+
+/**
+ * @brief Entry of the sentence dispatch table.
+ */
+struct nmea_handler {
+    char id[4];      /**< Sentence ID without talker (e.g. "GGA"). */
+    uint8_t flag;    /**< GPS_SENTENCE_* bit recorded once the sentence is merged. */
+    bool timed;      /**< Field 1 carries the UTC time that delimits epochs. */
+    bool (*parse)(const struct nmea_parser *p, gps_data_t *fix); /**< Sentence parser. */
+};
+
+/**
+ * @brief Parses a decimal NMEA field into a fixed-point integer.
+ *
+ * Converts strings such as "545.4" or "-12.05" into an integer scaled by
+ * 10^@p decimals (e.g. 54540 for two decimals). Extra fractional digits are
+ * truncated and missing ones are padded with zeros. No floating-point
+ * arithmetic is involved.
+ *
+ * @param s Pointer to the NUL-terminated field.
+ * @param decimals Number of fractional digits kept in the result.
+ * @param out Pointer to store the scaled value.
+ * @retval true If at least one digit was parsed.
+ * @retval false If the field is empty, malformed or does not fit in 32 bits.
+ */
+bool nmea_parse_fixed(const char *s, uint8_t decimals, int32_t *out)
+{
+    bool negative = false;
+    bool seen_dot = false;
+    bool seen_digit = false;
+    uint8_t frac_digits = 0;
+    int32_t value = 0;
+
+    if (*s == '-') {
+        negative = true;
+        s++;
+    }
+
+    for (; *s; s++) {
+        char c = *s;
+        if (c >= '0' && c <= '9') {
+            seen_digit = true;
+            if (seen_dot) {
+                if (frac_digits >= decimals) continue;
+                frac_digits++;
+            }
+            if (value > (INT32_MAX - 9) / 10) return false;
+            value = value * 10 + (c - '0');
+        } else if (c == '.' && !seen_dot) {
+            seen_dot = true;
+        } else {
+            return false;
+        }
+    }
+
+    if (!seen_digit) return false;
+
+    for (; frac_digits < decimals; frac_digits++) {
+        if (value > INT32_MAX / 10) return false;
+        value *= 10;
+    }
+
+    *out = negative ? -value : value;
+    return true;
+}
+
+/**
+ * @brief Converts an NMEA latitude/longitude field to microdegrees.
+ *
+ * Converts a coordinate in NMEA format ("DDMM.MMMM" or "DDDMM.MMMM")
+ * to signed microdegrees (degrees × 1e6), applying hemisphere correction
+ * based on the direction character. Minutes are kept with six fractional
+ * digits and divided by 60 with rounding, so the conversion is exact to the
+ * last microdegree and uses 32-bit integer arithmetic only.
+ *
+ * @param nmea Pointer to the NMEA coordinate string.
+ * @param dir Direction character ('N', 'S', 'E', or 'W').
+ * @param udeg Pointer to store the coordinate in microdegrees.
+ * @retval true If the coordinate was valid.
+ * @retval false If the field is empty, malformed or out of range.
+ */
+bool nmea_parse_coord(const char *nmea, char dir, int32_t *udeg)
+{
+    int32_t whole = 0;      /* DDDMM */
+    int32_t frac_e6 = 0;    /* Fractional minutes × 1e6 */
+    int32_t scale = 100000;
+    uint8_t int_digits = 0;
+
+    if (dir != 'N' && dir != 'S' && dir != 'E' && dir != 'W') return false;
+
+    for (; *nmea >= '0' && *nmea <= '9'; nmea++) {
+        if (++int_digits > 5) return false;
+        whole = whole * 10 + (*nmea - '0');
+    }
+    if (int_digits < 3) return false;
+
+    if (*nmea == '.') {
+        for (nmea++; *nmea >= '0' && *nmea <= '9'; nmea++) {
+            frac_e6 += (*nmea - '0') * scale;
+            scale /= 10;
+        }
+    }
+    if (*nmea != '\0') return false;
+
+    int32_t degrees = whole / 100;
+    int32_t minutes_e6 = (whole % 100) * 1000000 + frac_e6;
+
+    if (minutes_e6 >= 60000000) return false;
+    if (degrees > ((dir == 'N' || dir == 'S') ? 90 : 180)) return false;
+
+    int32_t result = degrees * 1000000 + (minutes_e6 + 30) / 60;
+
+    *udeg = (dir == 'S' || dir == 'W') ? -result : result;
+    return true;
+}
+
+/**
+ * @brief Returns a field of the sentence currently held by the parser.
+ *
+ * @param p Pointer to the parser context.
+ * @param idx Field index (0 = address field).
+ * @return Pointer to the NUL-terminated field, or an empty string if the
+ *         sentence has fewer fields.
+ */
+static const char *nmea_field(const struct nmea_parser *p, uint8_t idx)
+{
+    if (idx >= p->field_count) return "";
+    return &p->buf[p->field_start[idx]];
+}
+
+/**
+ * @brief Parses a two-digit decimal number.
+ *
+ * @param s Pointer to the two characters.
+ * @return Parsed value (0-99), or -1 if the characters are not digits.
+ */
+static int nmea_parse_2digits(const char *s)
+{
+    if (s[0] < '0' || s[0] > '9' || s[1] < '0' || s[1] > '9') return -1;
+    return (s[0] - '0') * 10 + (s[1] - '0');
+}
+
+/**
+ * @brief Parses an NMEA UTC time field ("hhmmss" or "hhmmss.sss").
+ *
+ * @param s Pointer to the NUL-terminated field.
+ * @param utc Pointer to the UTC structure whose time members are updated.
+ * @param tod_ms Pointer to store the time of day in milliseconds.
+ * @retval true If the field holds a valid time.
+ * @retval false If the field is empty, malformed or has trailing characters.
+ */
+static bool nmea_parse_time(const char *s, struct gps_utc *utc, uint32_t *tod_ms)
+{
+    int32_t msec = 0;
+
+    if (strlen(s) < 6) return false;
+
+    int hh = nmea_parse_2digits(&s[0]);
+    int mm = nmea_parse_2digits(&s[2]);
+    int ss = nmea_parse_2digits(&s[4]);
+    if (hh < 0 || hh > 23 || mm < 0 || mm > 59 || ss < 0 || ss > 60) return false;
+
+    /* Only a '.' and fractional digits may follow the seconds */
+    if (s[6] != '\0' && (s[6] != '.' || !nmea_parse_fixed(&s[6], 3, &msec))) return false;
+
+    utc->hour = (uint8_t)hh;
+    utc->minute = (uint8_t)mm;
+    utc->second = (uint8_t)ss;
+    utc->msec = (uint16_t)msec;
+
+    *tod_ms = (((uint32_t)hh * 60 + mm) * 60 + ss) * 1000 + msec;
+    return true;
+}
+
+/**
+ * @brief Parses the GGA sentence currently held by the parser.
+ *
+ * Extracts latitude, longitude, altitude, fix quality, HDOP and number of
+ * satellites from a GGA sentence into fixed-point values (microdegrees,
+ * centimetres, HDOP × 100) using integer arithmetic only. The checksum has
+ * already been validated.
+ *
+ * @param p Pointer to the parser context holding a complete GGA sentence.
+ * @param fix Pointer to the epoch being assembled.
+ * @retval true If parsing succeeded and valid data was extracted.
+ * @retval false If the sentence was invalid or incomplete.
+ */
+static bool parse_gga(const struct nmea_parser *p, gps_data_t *fix)
+{
+    /* Expected GGA field layout:
+     *  0 = GPGGA or GNGGA
+     *  1 = UTC time (hhmmss.ss)
+     *  2 = Latitude (DDMM.MMMM)
+     *  3 = N/S
+     *  4 = Longitude (DDDMM.MMMM)
+     *  5 = E/W
+     *  6 = Fix quality
+     *  7 = Number of satellites
+     *  8 = HDOP
+     *  9 = Altitude (meters)
+     */
+    if (p->field_count < 10) return false;
+
+    int32_t quality = 0;
+    int32_t sats = 0;
+    int32_t hdop = 0;
+
+    /* Empty position fields (no fix) are reported as zero */
+    if (!nmea_parse_coord(nmea_field(p, 2), nmea_field(p, 3)[0], &fix->lat) ||
+        !nmea_parse_coord(nmea_field(p, 4), nmea_field(p, 5)[0], &fix->lon)) {
+        fix->lat = 0;
+        fix->lon = 0;
+    }
+    if (!nmea_parse_fixed(nmea_field(p, 9), 2, &fix->alt)) fix->alt = 0;
+    if (!nmea_parse_fixed(nmea_field(p, 6), 0, &quality) || quality < 0 || quality > 9) quality = 0;
+    if (!nmea_parse_fixed(nmea_field(p, 7), 0, &sats)) sats = 0;
+    if (!nmea_parse_fixed(nmea_field(p, 8), 2, &hdop) || hdop < 0 || hdop > UINT16_MAX) hdop = 0;
+
+    fix->fix_quality = (uint8_t)quality;
+    fix->sats = (int)sats;
+    fix->hdop = (uint16_t)hdop;
+
+    return true;
+}
+
+/**
+ * @brief Parses the RMC sentence currently held by the parser.
+ *
+ * Extracts the receiver status, speed and course over ground and the UTC
+ * date. Position is taken from GGA, which also carries altitude.
+ *
+ * @param p Pointer to the parser context holding a complete RMC sentence.
+ * @param fix Pointer to the epoch being assembled.
+ * @retval true If parsing succeeded.
+ * @retval false If the sentence was incomplete.
+ */
+static bool parse_rmc(const struct nmea_parser *p, gps_data_t *fix)
+{
+    /* Expected RMC field layout:
+     *  0 = GPRMC or GNRMC
+     *  1 = UTC time (hhmmss.ss)
+     *  2 = Status (A = valid, V = warning)
+     *  3-6 = Latitude, N/S, Longitude, E/W
+     *  7 = Speed over ground (knots)
+     *  8 = Course over ground (degrees)
+     *  9 = Date (ddmmyy)
+     */
+    if (p->field_count < 10) return false;
+
+    int32_t knots100 = 0;
+    int32_t course100 = 0;
+    const char *date = nmea_field(p, 9);
+
+    fix->valid = (nmea_field(p, 2)[0] == 'A');
+
+    /* VTG reports km/h directly and takes precedence when present */
+    if (nmea_parse_fixed(nmea_field(p, 7), 2, &knots100) && knots100 >= 0) {
+        fix->speed = (uint32_t)(((int64_t)knots100 * 1852 + 500) / 1000);
+    }
+    if (nmea_parse_fixed(nmea_field(p, 8), 2, &course100) && course100 >= 0 && course100 < 36000) {
+        fix->course = (uint16_t)course100;
+    }
+
+    if (strlen(date) == 6) {
+        int dd = nmea_parse_2digits(&date[0]);
+        int mo = nmea_parse_2digits(&date[2]);
+        int yy = nmea_parse_2digits(&date[4]);
+        if (dd >= 1 && dd <= 31 && mo >= 1 && mo <= 12 && yy >= 0) {
+            fix->utc.day = (uint8_t)dd;
+            fix->utc.month = (uint8_t)mo;
+            fix->utc.year = (uint16_t)(2000 + yy);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Parses the GSA sentence currently held by the parser.
+ *
+ * Extracts the fix mode and the position, horizontal and vertical dilution
+ * of precision (× 100).
+ *
+ * @param p Pointer to the parser context holding a complete GSA sentence.
+ * @param fix Pointer to the epoch being assembled.
+ * @retval true If parsing succeeded.
+ * @retval false If the sentence was incomplete.
+ */
+static bool parse_gsa(const struct nmea_parser *p, gps_data_t *fix)
+{
+    /* Expected GSA field layout:
+     *  0 = GPGSA or GNGSA
+     *  1 = Selection mode (M/A)
+     *  2 = Fix mode (1 = none, 2 = 2D, 3 = 3D)
+     *  3-14 = PRNs of satellites used
+     *  15 = PDOP
+     *  16 = HDOP
+     *  17 = VDOP
+     */
+    if (p->field_count < 18) return false;
+
+    int32_t mode = 0;
+    int32_t pdop = 0;
+    int32_t vdop = 0;
+
+    if (nmea_parse_fixed(nmea_field(p, 2), 0, &mode) && mode >= 1 && mode <= 3) {
+        fix->fix_mode = (uint8_t)mode;
+    }
+    if (nmea_parse_fixed(nmea_field(p, 15), 2, &pdop) && pdop >= 0 && pdop <= UINT16_MAX) {
+        fix->pdop = (uint16_t)pdop;
+    }
+    if (nmea_parse_fixed(nmea_field(p, 17), 2, &vdop) && vdop >= 0 && vdop <= UINT16_MAX) {
+        fix->vdop = (uint16_t)vdop;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Parses the VTG sentence currently held by the parser.
+ *
+ * Extracts the true course and the speed over ground in km/h.
+ *
+ * @param p Pointer to the parser context holding a complete VTG sentence.
+ * @param fix Pointer to the epoch being assembled.
+ * @retval true If parsing succeeded.
+ * @retval false If the sentence was incomplete.
+ */
+static bool parse_vtg(const struct nmea_parser *p, gps_data_t *fix)
+{
+    /* Expected VTG field layout:
+     *  0 = GPVTG or GNVTG
+     *  1 = Course over ground (true), 2 = 'T'
+     *  3 = Course over ground (magnetic), 4 = 'M'
+     *  5 = Speed (knots), 6 = 'N'
+     *  7 = Speed (km/h), 8 = 'K'
+     */
+    if (p->field_count < 9) return false;
+
+    int32_t course100 = 0;
+    int32_t kmh100 = 0;
+
+    if (nmea_parse_fixed(nmea_field(p, 1), 2, &course100) && course100 >= 0 && course100 < 36000) {
+        fix->course = (uint16_t)course100;
+    }
+    if (nmea_parse_fixed(nmea_field(p, 7), 2, &kmh100) && kmh100 >= 0) {
+        fix->speed = (uint32_t)kmh100;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Parses a PMTK001 acknowledgement.
+ *
+ * Reports the acknowledged command and its result flag through the
+ * parser's acknowledgement callback. The fix is not modified.
+ *
+ * @param p Pointer to the parser context holding a complete PMTK001 sentence.
+ * @param fix Unused.
+ * @retval true If the acknowledgement was well formed.
+ * @retval false Otherwise.
+ */
+static bool parse_pmtk_ack(const struct nmea_parser *p, gps_data_t *fix)
+{
+    /* Expected PMTK001 field layout:
+     *  0 = PMTK001
+     *  1 = Acknowledged command number
+     *  2 = Flag (0 = invalid, 1 = unsupported, 2 = failed, 3 = success)
+     */
+    int32_t cmd = 0;
+    int32_t flag = 0;
+
+    (void)fix;
+
+    if (!nmea_parse_fixed(nmea_field(p, 1), 0, &cmd) || cmd < 0 || cmd > 0xFFFF) return false;
+    if (!nmea_parse_fixed(nmea_field(p, 2), 0, &flag) || flag < 0 || flag > 0xFF) return false;
+
+    if (p->on_ack) p->on_ack((uint16_t)cmd, (uint8_t)flag, p->user_data);
+    return true;
+}
+
+/**
+ * @brief Handler for PMTK001 acknowledgements (not part of any epoch).
+ */
+static const struct nmea_handler pmtk_ack_handler = { "001", 0, false, parse_pmtk_ack };
+
+/**
+ * @brief Sentence dispatch table.
+ *
+ * Each supported sentence ID maps to its parser and to the bit recorded in
+ * the epoch mask once the sentence has been merged. Sentences flagged as
+ * @c timed carry the UTC time in field 1 and delimit NMEA epochs.
+ */
+static const struct nmea_handler nmea_handlers[] = {
+    { "GGA", GPS_SENTENCE_GGA, true,  parse_gga },
+    { "RMC", GPS_SENTENCE_RMC, true,  parse_rmc },
+    { "GSA", GPS_SENTENCE_GSA, false, parse_gsa },
+    { "VTG", GPS_SENTENCE_VTG, false, parse_vtg },
+};
+
+/**
+ * @brief Identifies the sentence type from the address field.
+ *
+ * Only the talker IDs of the supported constellations are accepted, so
+ * unsupported sentences are discarded right after their six-byte header
+ * ("$" + address). The only proprietary sentence kept is the seven-character
+ * PMTK001 acknowledgement.
+ *
+ * @param addr Pointer to the address characters (not NUL-terminated).
+ * @param len Number of address characters.
+ * @return Matching handler, or NULL if unsupported.
+ */
+static const struct nmea_handler *nmea_identify(const char *addr, uint8_t len)
+{
+    if (len == PMTK_ADDR_LEN) {
+        return (memcmp(addr, "PMTK001", PMTK_ADDR_LEN) == 0) ? &pmtk_ack_handler : NULL;
+    }
+    if (len != NMEA_ADDR_LEN) return NULL;
+
+    switch (addr[0]) {
+    case 'G':
+        switch (addr[1]) {
+        case 'P': /* GPS */
+        case 'N': /* Multi-constellation */
+        case 'L': /* GLONASS */
+        case 'A': /* Galileo */
+            break;
+        default:
+            return NULL;
+        }
+        break;
+    case 'B':
+        if (addr[1] != 'D') return NULL; /* BeiDou */
+        break;
+    default:
+        return NULL;
+    }
+
+    for (size_t i = 0; i < sizeof(nmea_handlers) / sizeof(nmea_handlers[0]); i++) {
+        if (memcmp(&addr[2], nmea_handlers[i].id, 3) == 0) {
+            return &nmea_handlers[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Converts an ASCII hexadecimal digit to its value.
+ *
+ * @param c Character to convert.
+ * @return Value 0-15, or -1 if @p c is not a hexadecimal digit.
+ */
+static int hex_value(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+/**
+ * @brief Stores one character into the current field.
+ *
+ * @param p Pointer to the parser context.
+ * @param c Character to store.
+ * @retval true If the character was stored.
+ * @retval false If the sentence exceeds @ref NMEA_BUF_SIZE.
+ */
+static bool nmea_store(struct nmea_parser *p, char c)
+{
+    if (p->pos >= (NMEA_BUF_SIZE - 1)) return false;
+    p->buf[p->pos++] = c;
+    return true;
+}
+
+/**
+ * @brief Terminates the current field and opens the next one.
+ *
+ * @param p Pointer to the parser context.
+ * @retval true If a new field was opened.
+ * @retval false If the sentence exceeds @ref NMEA_BUF_SIZE or @ref NMEA_MAX_FIELDS.
+ */
+static bool nmea_next_field(struct nmea_parser *p)
+{
+    if (!nmea_store(p, '\0') || p->field_count >= NMEA_MAX_FIELDS) return false;
+    p->field_start[p->field_count++] = p->pos;
+    return true;
+}
+
+/**
+ * @brief Publishes the epoch being assembled.
+ *
+ * Stamps the fused fix with a new sequence number and hands it to the
+ * parser's fix callback. Each epoch is published at most once.
+ *
+ * @param p Pointer to the parser context.
+ */
+static void nmea_publish_epoch(struct nmea_parser *p)
+{
+    if (p->epoch_done || p->epoch_mask == 0) return;
+
+    p->epoch.seq = ++p->epoch_seq;
+    p->epoch.sentences = p->epoch_mask;
+    if (p->on_fix) p->on_fix(&p->epoch, p->user_data);
+
+    p->epoch_done = true;
+}
+
+/**
+ * @brief Dispatches a complete, checksum-validated sentence.
+ *
+ * Sentences are merged into the epoch being assembled. A timed sentence
+ * (GGA, RMC) whose UTC time differs from the current epoch closes it, so
+ * an incomplete epoch is still published once. An epoch is published as
+ * soon as all expected sentences have been merged; consumers therefore
+ * never see a half-updated fix.
+ *
+ * @param p Pointer to the parser context.
+ */
+static void nmea_dispatch(struct nmea_parser *p)
+{
+    const struct nmea_handler *h = p->handler;
+
+    if (h->timed) {
+        struct gps_utc utc = p->epoch.utc;
+        uint32_t tod_ms;
+
+        if (!nmea_parse_time(nmea_field(p, 1), &utc, &tod_ms)) return;
+
+        if (tod_ms != p->epoch_tod_ms) {
+            nmea_publish_epoch(p);
+
+            /* Start a clean epoch; only the date survives until the next RMC */
+            memset(&p->epoch, 0, sizeof(p->epoch));
+            p->epoch_tod_ms = tod_ms;
+            p->epoch_mask = 0;
+            p->epoch_done = false;
+        }
+        p->epoch.utc = utc;
+    }
+
+    if (!h->parse(p, &p->epoch) || h->flag == 0) return;
+
+    p->epoch_mask |= h->flag;
+    if ((p->epoch_mask & p->epoch_expected) == p->epoch_expected) {
+        nmea_publish_epoch(p);
+    }
+}
+
+/**
+ * @brief Feeds one received byte into the streaming NMEA parser.
+ *
+ * Single-pass state machine: fields are tokenized in place as bytes arrive,
+ * the XOR checksum is accumulated on the fly and unsupported sentences are
+ * dropped as soon as their address is known. A sentence is only dispatched
+ * once its "*hh" checksum has been received and matches, so corrupt data
+ * never reaches the numeric conversions.
+ */
+void nmea_process_byte(struct nmea_parser *p, uint8_t c)
+{
+    if (c == '$') {
+        p->state = NMEA_ADDRESS;
+        p->handler = NULL;
+        p->pos = 0;
+        p->field_count = 1;
+        p->field_start[0] = 0;
+        p->checksum = 0;
+        return;
+    }
+
+    switch (p->state) {
+    case NMEA_ADDRESS:
+        p->checksum ^= c;
+        if (c == ',') {
+            p->handler = nmea_identify(p->buf, p->pos);
+            p->state = (p->handler != NULL && nmea_next_field(p)) ? NMEA_FIELDS : NMEA_WAIT_START;
+        } else if (p->pos < PMTK_ADDR_LEN) {
+            p->buf[p->pos++] = (char)c;
+            /* Drop unsupported sentences after "$" + 5 address bytes; only PMTK0xx needs more */
+            if (p->pos == NMEA_ADDR_LEN && nmea_identify(p->buf, NMEA_ADDR_LEN) == NULL &&
+                memcmp(p->buf, "PMTK0", NMEA_ADDR_LEN) != 0) {
+                p->state = NMEA_WAIT_START;
+            }
+        } else {
+            p->state = NMEA_WAIT_START;
+        }
+        break;
+
+    case NMEA_FIELDS:
+        if (c == '*') {
+            p->buf[p->pos] = '\0';
+            p->state = NMEA_CHECKSUM_HI;
+            break;
+        }
+
+        p->checksum ^= c;
+        if (c == ',') {
+            if (!nmea_next_field(p)) p->state = NMEA_WAIT_START;
+        } else if (c == '\r' || c == '\n' || !nmea_store(p, (char)c)) {
+            /* Missing checksum or oversized sentence */
+            p->state = NMEA_WAIT_START;
+        }
+        break;
+
+    case NMEA_CHECKSUM_HI:
+        if (hex_value((char)c) < 0) {
+            p->state = NMEA_WAIT_START;
+            break;
+        }
+        p->rx_checksum = (uint8_t)(hex_value((char)c) << 4);
+        p->state = NMEA_CHECKSUM_LO;
+        break;
+
+    case NMEA_CHECKSUM_LO:
+        p->state = NMEA_WAIT_START;
+        if (hex_value((char)c) < 0) break;
+
+        p->rx_checksum |= (uint8_t)hex_value((char)c);
+        if (p->rx_checksum == p->checksum) {
+            nmea_dispatch(p);
+        }
+        break;
+
+    case NMEA_WAIT_START:
+    default:
+        break;
+    }
+}
+
+void nmea_parser_init(struct nmea_parser *p, nmea_fix_cb_t on_fix,
+                      nmea_ack_cb_t on_ack, void *user_data)
+{
+    memset(p, 0, sizeof(*p));
+    p->state = NMEA_WAIT_START;
+    p->epoch_tod_ms = UINT32_MAX;
+    p->epoch_expected = GPS_SENTENCE_ALL;
+    p->on_fix = on_fix;
+    p->on_ack = on_ack;
+    p->user_data = user_data;
+}
+
+void nmea_set_expected(struct nmea_parser *p, uint8_t sentences)
+{
+    p->epoch_expected = sentences & GPS_SENTENCE_ALL;
+}
@@ -0,0 +1,197 @@
+/**
+ * @file nmea.h
+ * @brief Platform-independent streaming NMEA parser.
+ *
+ * This module holds the parsing core of the GPS driver: the byte-level
+ * NMEA state machine, the GGA/RMC/GSA/VTG sentence parsers, epoch fusion
+ * and the PMTK001 acknowledgement decoder. It only depends on the C
+ * standard library, so it can be built for the target and for a host
+ * machine alike (e.g. for benchmarks or fuzzing).
+ *
+ * Functions:
+ *  - @ref nmea_parser_init() to reset a parser and register its callbacks.
+ *  - @ref nmea_set_expected() to select the sentences that complete an epoch.
+ *  - @ref nmea_process_byte() to feed received bytes into the parser.
+ *  - @ref nmea_parse_fixed() / @ref nmea_parse_coord() for integer field conversions.
+ */
+
+#ifndef NMEA_H_
+#define NMEA_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define NMEA_BUF_SIZE 128    /**< Maximum NMEA sentence length. */
+#define NMEA_MAX_FIELDS 20   /**< Maximum number of comma-separated fields per sentence. */
+
+/* NMEA sentences merged into a fix (see @ref gps_data_t::sentences) */
+#define GPS_SENTENCE_GGA  (1U << 0)  /**< Fix data: position, altitude, satellites, HDOP. */
+#define GPS_SENTENCE_RMC  (1U << 1)  /**< Recommended minimum: status, date, speed, course. */
+#define GPS_SENTENCE_GSA  (1U << 2)  /**< DOP and active satellites: fix mode, PDOP, VDOP. */
+#define GPS_SENTENCE_VTG  (1U << 3)  /**< Course and speed over ground. */
+#define GPS_SENTENCE_ALL  (GPS_SENTENCE_GGA | GPS_SENTENCE_RMC | GPS_SENTENCE_GSA | GPS_SENTENCE_VTG)
+
+/**
+ * @brief UTC date and time reported by the receiver.
+ *
+ * The date is only known once an RMC sentence has been received.
+ */
+struct gps_utc {
+    uint16_t year;    /**< Year (e.g. 2025), 0 if unknown. */
+    uint8_t  month;   /**< Month (1-12), 0 if unknown. */
+    uint8_t  day;     /**< Day of month (1-31), 0 if unknown. */
+    uint8_t  hour;    /**< Hour (0-23). */
+    uint8_t  minute;  /**< Minute (0-59). */
+    uint8_t  second;  /**< Second (0-60). */
+    uint16_t msec;    /**< Milliseconds (0-999). */
+};
+
+/**
+ * @brief Fused GPS fix for one NMEA epoch.
+ *
+ * Contains geographic and fix-related data merged from the GGA, RMC, GSA
+ * and VTG sentences that share the same UTC time. All numeric fields are
+ * fixed-point integers, so they can be packed into the LoRaWAN payload
+ * without any floating-point conversion.
+ */
+typedef struct {
+    uint32_t seq;           /**< Epoch sequence number, incremented on every published fix. */
+    uint8_t  sentences;     /**< GPS_SENTENCE_* bits merged into this epoch. */
+    int32_t  lat;           /**< Latitude in microdegrees (degrees × 1e6). */
+    int32_t  lon;           /**< Longitude in microdegrees (degrees × 1e6). */
+    int32_t  alt;           /**< Altitude in centimetres above mean sea level. */
+    int      sats;          /**< Number of satellites currently in use. */
+    uint8_t  fix_quality;   /**< GGA fix quality (0 = invalid, 1 = GPS, 2 = DGPS, ...). */
+    uint8_t  fix_mode;      /**< GSA fix mode (1 = no fix, 2 = 2D, 3 = 3D), 0 if unknown. */
+    bool     valid;         /**< RMC status ('A' = valid). */
+    uint16_t hdop;          /**< Horizontal dilution of precision × 100. */
+    uint16_t pdop;          /**< Position dilution of precision × 100. */
+    uint16_t vdop;          /**< Vertical dilution of precision × 100. */
+    uint32_t speed;         /**< Speed over ground in km/h × 100. */
+    uint16_t course;        /**< True course over ground in degrees × 100. */
+    struct gps_utc utc;     /**< UTC date and time of the epoch. */
+    int64_t  uptime;        /**< Uptime (ms) at which the epoch was published, set by the platform driver (0 from the parser). */
+} gps_data_t;
+
+/**
+ * @brief States of the streaming NMEA parser.
+ */
+enum nmea_state {
+    NMEA_WAIT_START = 0,  /**< Waiting for the '$' start delimiter. */
+    NMEA_ADDRESS,         /**< Receiving the talker and sentence IDs. */
+    NMEA_FIELDS,          /**< Receiving comma-separated data fields. */
+    NMEA_CHECKSUM_HI,     /**< Receiving the high checksum nibble. */
+    NMEA_CHECKSUM_LO,     /**< Receiving the low checksum nibble. */
+};
+
+struct nmea_parser;
+
+/**
+ * @brief Callback invoked for every published epoch.
+ *
+ * @param fix Pointer to the fused fix, only valid during the call.
+ * @param user_data Opaque pointer given to @ref nmea_parser_init().
+ */
+typedef void (*nmea_fix_cb_t)(const gps_data_t *fix, void *user_data);
+
+/**
+ * @brief Callback invoked for every PMTK001 acknowledgement.
+ *
+ * @param cmd Acknowledged PMTK command number.
+ * @param flag Result flag (0 = invalid, 1 = unsupported, 2 = failed, 3 = success).
+ * @param user_data Opaque pointer given to @ref nmea_parser_init().
+ */
+typedef void (*nmea_ack_cb_t)(uint16_t cmd, uint8_t flag, void *user_data);
+
+/**
+ * @brief Streaming NMEA parser context.
+ *
+ * Fields are stored in place in @ref buf: each ',' is replaced by a NUL
+ * terminator as it arrives and the start offset of every field is recorded,
+ * so the parsed sentence is never copied. Field 0 holds the address
+ * (e.g. "GPGGA"). The parser also owns the epoch being fused, so several
+ * independent instances can run side by side.
+ */
+struct nmea_parser {
+    enum nmea_state state;              /**< Current parser state. */
+    const struct nmea_handler *handler; /**< Handler decoded from the address field. */
+    char buf[NMEA_BUF_SIZE];            /**< NUL-separated field storage. */
+    uint8_t pos;                        /**< Write position in @ref buf. */
+    uint8_t field_start[NMEA_MAX_FIELDS]; /**< Offset of each field in @ref buf. */
+    uint8_t field_count;                /**< Number of fields received so far. */
+    uint8_t checksum;                   /**< Running XOR of all bytes between '$' and '*'. */
+    uint8_t rx_checksum;                /**< Checksum transmitted after '*'. */
+
+    gps_data_t epoch;                   /**< Epoch being assembled from the current NMEA burst. */
+    uint32_t epoch_tod_ms;              /**< Time of day (ms) of @ref epoch, UINT32_MAX if unknown. */
+    uint8_t epoch_mask;                 /**< GPS_SENTENCE_* bits merged into @ref epoch. */
+    uint8_t epoch_expected;             /**< Sentences that complete an epoch and trigger its publication. */
+    bool epoch_done;                    /**< Whether @ref epoch has already been published. */
+    uint32_t epoch_seq;                 /**< Sequence number of the last published epoch. */
+
+    nmea_fix_cb_t on_fix;               /**< Called for every published epoch. */
+    nmea_ack_cb_t on_ack;               /**< Called for every PMTK001 acknowledgement. */
+    void *user_data;                    /**< Opaque pointer passed to the callbacks. */
+};
+
+
+/**
+ * @brief Resets a parser and registers its callbacks.
+ *
+ * All GGA, RMC, GSA and VTG sentences are expected in each epoch until
+ * @ref nmea_set_expected() is called.
+ *
+ * @param p Pointer to the parser context.
+ * @param on_fix Callback for published epochs (may be NULL).
+ * @param on_ack Callback for PMTK001 acknowledgements (may be NULL).
+ * @param user_data Opaque pointer passed to the callbacks.
+ */
+void nmea_parser_init(struct nmea_parser *p, nmea_fix_cb_t on_fix,
+                      nmea_ack_cb_t on_ack, void *user_data);
+
+/**
+ * @brief Selects the sentences that complete an epoch.
+ *
+ * An epoch is published as soon as all of these sentences have been merged,
+ * otherwise when the next epoch starts.
+ *
+ * @param p Pointer to the parser context.
+ * @param sentences GPS_SENTENCE_* mask.
+ */
+void nmea_set_expected(struct nmea_parser *p, uint8_t sentences);
+
+/**
+ * @brief Feeds one received byte into the parser.
+ *
+ * Callbacks are invoked synchronously from this function. A parser instance
+ * must only be fed from one thread.
+ *
+ * @param p Pointer to the parser context.
+ * @param c Received byte.
+ */
+void nmea_process_byte(struct nmea_parser *p, uint8_t c);
+
+/**
+ * @brief Parses a decimal NMEA field into a fixed-point integer.
+ *
+ * @param s Pointer to the NUL-terminated field.
+ * @param decimals Number of fractional digits kept in the result.
+ * @param out Pointer to store the value scaled by 10^@p decimals.
+ * @retval true If at least one digit was parsed.
+ * @retval false If the field is empty, malformed or does not fit in 32 bits.
+ */
+bool nmea_parse_fixed(const char *s, uint8_t decimals, int32_t *out);
+
+/**
+ * @brief Converts an NMEA coordinate (DDMM.MMMM / DDDMM.MMMM) to microdegrees.
+ *
+ * @param nmea Pointer to the NUL-terminated coordinate field.
+ * @param dir Direction character ('N', 'S', 'E', or 'W').
+ * @param udeg Pointer to store the signed coordinate in microdegrees.
+ * @retval true If the coordinate was valid.
+ * @retval false If the field is empty, malformed or out of range.
+ */
+bool nmea_parse_coord(const char *nmea, char dir, int32_t *udeg);
+
+#endif /* NMEA_H_ */
@@ -111,15 +111,173 @@ int accel_init(const struct i2c_dt_spec *dev, uint8_t range) {
  * @return 0 on success, negative errno code on failure.
  */
 int accel_read_xyz(const struct i2c_dt_spec *dev, int16_t *x, int16_t *y, int16_t *z) {
-    uint8_t buf[6];
-    int ret = i2c_read_regs(dev, ACCEL_REG_OUT_X_MSB, buf, 6);
+    uint8_t buf[ACCEL_XYZ_SIZE];
+    struct i2c_batch batch;
+
+    i2c_batch_init(&batch);
+    accel_queue_xyz(&batch, dev, buf);
+
+    int ret = i2c_batch_submit(&batch);
+    if (ret == 0) ret = i2c_batch_wait(&batch);
     if (ret < 0) return ret;
 
+    accel_decode_xyz(buf, x, y, z);
+    return 0;
+}
+
+/**
+ * @brief Queue the X/Y/Z output burst in an I2C batch.
+ *
+ * @param batch Batch to add the transaction to.
+ * @param dev Pointer to I2C device descriptor.
+ * @param buf Buffer of ACCEL_XYZ_SIZE bytes.
+ * @return The queued transaction, or NULL if the batch is full.
+ */
+struct i2c_batch_op *accel_queue_xyz(struct i2c_batch *batch, const struct i2c_dt_spec *dev,
+                                     uint8_t *buf) {
+    return i2c_batch_read_regs(batch, dev, ACCEL_REG_OUT_X_MSB, buf, ACCEL_XYZ_SIZE);
+}
+
+/**
+ * @brief Decode the X/Y/Z output burst.
+ *
+ * Each axis is 14-bit, left-aligned in MSB/LSB registers.
+ *
+ * @param buf Burst read from ACCEL_REG_OUT_X_MSB.
+ * @param x Pointer to store X-axis raw value.
+ * @param y Pointer to store Y-axis raw value.
+ * @param z Pointer to store Z-axis raw value.
+ */
+void accel_decode_xyz(const uint8_t *buf, int16_t *x, int16_t *y, int16_t *z) {
     *x = (int16_t)(((int16_t)((buf[0] << 8) | buf[1])) >> 2);
     *y = (int16_t)(((int16_t)((buf[2] << 8) | buf[3])) >> 2);
     *z = (int16_t)(((int16_t)((buf[4] << 8) | buf[5])) >> 2);
+}
 
-    return 0;
+/**
+ * @brief Set bits of a register (read-modify-write).
+ *
+ * @param dev Pointer to I2C device descriptor.
+ * @param reg Register address.
+ * @param bits Bits to set.
+ * @return 0 on success, negative errno code on failure.
+ */
+static int accel_set_bits(const struct i2c_dt_spec *dev, uint8_t reg, uint8_t bits) {
+    uint8_t val;
+    int ret = i2c_read_regs(dev, reg, &val, 1);
+    if (ret < 0) return ret;
+
+    return i2c_write_reg(dev, reg, val | bits);
+}
+
+/**
+ * @brief Enable the FIFO in circular mode with a watermark interrupt on INT1.
+ *
+ * The FIFO and data rate can only be changed in standby mode. INT1 keeps
+ * its reset configuration: active low, push-pull.
+ *
+ * @param dev Pointer to I2C device descriptor.
+ * @param odr Output data rate (ACCEL_ODR_*).
+ * @param watermark Samples (1–32) that raise the interrupt.
+ * @return 0 on success, negative errno code on failure.
+ */
+int accel_fifo_enable(const struct i2c_dt_spec *dev, uint8_t odr, uint8_t watermark) {
+    if (watermark == 0 || watermark > ACCEL_FIFO_SIZE) return -EINVAL;
+
+    int ret = accel_set_standby(dev);
+    if (ret < 0) return ret;
+
+    uint8_t reg;
+    ret = i2c_read_regs(dev, ACCEL_REG_CTRL1, &reg, 1);
+    if (ret < 0) return ret;
+    reg = (reg & ~ACCEL_CTRL1_DR_MASK) | ((odr << 3) & ACCEL_CTRL1_DR_MASK);
+    ret = i2c_write_reg(dev, ACCEL_REG_CTRL1, reg);
+    if (ret < 0) return ret;
+
+    /* F_MODE can only change from disabled */
+    ret = i2c_write_reg(dev, ACCEL_REG_F_SETUP, 0);
+    if (ret < 0) return ret;
+    ret = i2c_write_reg(dev, ACCEL_REG_F_SETUP, ACCEL_F_MODE_CIRCULAR | watermark);
+    if (ret < 0) return ret;
+
+    ret = accel_set_bits(dev, ACCEL_REG_CTRL4, ACCEL_INT_FIFO);
+    if (ret < 0) return ret;
+    ret = accel_set_bits(dev, ACCEL_REG_CTRL5, ACCEL_INT_FIFO);
+    if (ret < 0) return ret;
+
+    printk("[ACCEL] - FIFO enabled (watermark %u)\n", watermark);
+    return accel_set_active(dev);
+}
+
+/**
+ * @brief Enable the freefall and transient engines on INT1.
+ *
+ * @param dev Pointer to I2C device descriptor.
+ * @param ff_mg Freefall threshold (mg), 0 to disable.
+ * @param ff_count Freefall debounce (samples).
+ * @param shock_mg Transient threshold (mg), 0 to disable.
+ * @param shock_count Transient debounce (samples).
+ * @return 0 on success, negative errno code on failure.
+ */
+int accel_events_enable(const struct i2c_dt_spec *dev, uint16_t ff_mg, uint8_t ff_count,
+                        uint16_t shock_mg, uint8_t shock_count) {
+    uint8_t irq = 0;
+
+    int ret = accel_set_standby(dev);
+    if (ret < 0) return ret;
+
+    if (ff_mg > 0) {
+        ret = i2c_write_reg(dev, ACCEL_REG_FF_MT_CFG, ACCEL_FF_MT_CFG_FREEFALL);
+        if (ret == 0) ret = i2c_write_reg(dev, ACCEL_REG_FF_MT_THS, ACCEL_THS_DBCNTM | ACCEL_THS_MG(ff_mg));
+        if (ret == 0) ret = i2c_write_reg(dev, ACCEL_REG_FF_MT_COUNT, ff_count);
+        if (ret < 0) return ret;
+        irq |= ACCEL_INT_FF_MT;
+    }
+
+    if (shock_mg > 0) {
+        ret = i2c_write_reg(dev, ACCEL_REG_TRANSIENT_CFG, ACCEL_TRANSIENT_CFG_XYZ);
+        if (ret == 0) ret = i2c_write_reg(dev, ACCEL_REG_TRANSIENT_THS, ACCEL_THS_DBCNTM | ACCEL_THS_MG(shock_mg));
+        if (ret == 0) ret = i2c_write_reg(dev, ACCEL_REG_TRANSIENT_COUNT, shock_count);
+        if (ret < 0) return ret;
+        irq |= ACCEL_INT_TRANS;
+    }
+
+    /* Enable and route to INT1 */
+    ret = accel_set_bits(dev, ACCEL_REG_CTRL4, irq);
+    if (ret < 0) return ret;
+    ret = accel_set_bits(dev, ACCEL_REG_CTRL5, irq);
+    if (ret < 0) return ret;
+
+    printk("[ACCEL] - Freefall %u mg / shock %u mg detection enabled\n", ff_mg, shock_mg);
+    return accel_set_active(dev);
+}
+
+/**
+ * @brief Queue a FIFO drain (F_STATUS + samples) in an I2C batch.
+ *
+ * @param batch Batch to add the transaction to.
+ * @param dev Pointer to I2C device descriptor.
+ * @param buf Buffer of 1 + count × ACCEL_XYZ_SIZE bytes.
+ * @param count Samples to read.
+ * @return The queued transaction, or NULL if the batch is full.
+ */
+struct i2c_batch_op *accel_queue_fifo(struct i2c_batch *batch, const struct i2c_dt_spec *dev,
+                                      uint8_t *buf, uint8_t count) {
+    return i2c_batch_read_regs(batch, dev, ACCEL_REG_STATUS, buf, 1 + count * ACCEL_XYZ_SIZE);
+}
+
+/**
+ * @brief Sample period of an output data rate.
+ *
+ * @param odr Output data rate (ACCEL_ODR_*).
+ * @return Period between samples in microseconds.
+ */
+uint32_t accel_odr_period_us(uint8_t odr) {
+    static const uint32_t period_us[] = {
+        1250, 2500, 5000, 10000, 20000, 80000, 160000, 640000,
+    };
+
+    return period_us[odr & 0x07];
 }
 
 /**
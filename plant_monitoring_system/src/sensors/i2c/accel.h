@@ -10,6 +10,7 @@
 #ifndef ACCEL_H
 #define ACCEL_H
 
+#include "i2c.h"
 #include <zephyr/device.h>
 #include <zephyr/drivers/i2c.h>
 #include <stdint.h>
@@ -22,6 +23,53 @@
 /* Power control registers */
 #define ACCEL_REG_CTRL1         0x2A        /**< Control register 1 */
 #define ACCEL_REG_CTRL2         0x2B        /**< Control register 2 */
+#define ACCEL_REG_CTRL3         0x2C        /**< Control register 3 (interrupt polarity) */
+#define ACCEL_REG_CTRL4         0x2D        /**< Control register 4 (interrupt enable) */
+#define ACCEL_REG_CTRL5         0x2E        /**< Control register 5 (interrupt routing) */
+
+/* Output data rate (CTRL_REG1 DR field) */
+#define ACCEL_CTRL1_DR_MASK     0x38        /**< DR bits of CTRL_REG1 */
+#define ACCEL_ODR_800HZ         0x00        /**< 800 Hz */
+#define ACCEL_ODR_400HZ         0x01        /**< 400 Hz */
+#define ACCEL_ODR_200HZ         0x02        /**< 200 Hz */
+#define ACCEL_ODR_100HZ         0x03        /**< 100 Hz */
+#define ACCEL_ODR_50HZ          0x04        /**< 50 Hz */
+#define ACCEL_ODR_12_5HZ        0x05        /**< 12.5 Hz */
+#define ACCEL_ODR_6_25HZ        0x06        /**< 6.25 Hz */
+#define ACCEL_ODR_1_56HZ        0x07        /**< 1.56 Hz */
+
+/* FIFO */
+#define ACCEL_REG_STATUS        0x00        /**< F_STATUS when the FIFO is enabled */
+#define ACCEL_REG_F_SETUP       0x09        /**< FIFO setup register */
+#define ACCEL_FIFO_SIZE         32          /**< FIFO depth (samples) */
+#define ACCEL_F_MODE_CIRCULAR   0x40        /**< F_MODE: circular buffer, oldest samples overwritten */
+#define ACCEL_F_STATUS_OVF      0x80        /**< FIFO overflowed since the last read */
+#define ACCEL_F_STATUS_CNT(s)   ((s) & 0x3F) /**< Samples stored in the FIFO */
+#define ACCEL_INT_FIFO          0x40        /**< FIFO bit of CTRL_REG4/CTRL_REG5 (enable / route to INT1) */
+
+/* Interrupt source */
+#define ACCEL_REG_INT_SOURCE    0x0C        /**< System interrupt status */
+#define ACCEL_INT_TRANS         0x20        /**< Transient bit of INT_SOURCE/CTRL_REG4/CTRL_REG5 */
+#define ACCEL_INT_FF_MT         0x04        /**< Freefall/motion bit of INT_SOURCE/CTRL_REG4/CTRL_REG5 */
+
+/* Freefall/motion engine */
+#define ACCEL_REG_FF_MT_CFG     0x15        /**< Freefall/motion configuration */
+#define ACCEL_REG_FF_MT_SRC     0x16        /**< Freefall/motion source (read clears the latch) */
+#define ACCEL_REG_FF_MT_THS     0x17        /**< Freefall/motion threshold (0.063 g/LSB) */
+#define ACCEL_REG_FF_MT_COUNT   0x18        /**< Freefall/motion debounce count (ODR steps) */
+#define ACCEL_FF_MT_CFG_FREEFALL 0xB8       /**< ELE latch, X/Y/Z all below threshold (OAE = 0) */
+#define ACCEL_FF_MT_SRC_EA      0x80        /**< Freefall/motion event active */
+
+/* Transient engine */
+#define ACCEL_REG_TRANSIENT_CFG   0x1D      /**< Transient configuration */
+#define ACCEL_REG_TRANSIENT_SRC   0x1E      /**< Transient source (read clears the latch) */
+#define ACCEL_REG_TRANSIENT_THS   0x1F      /**< Transient threshold (0.063 g/LSB) */
+#define ACCEL_REG_TRANSIENT_COUNT 0x20      /**< Transient debounce count (ODR steps) */
+#define ACCEL_TRANSIENT_CFG_XYZ   0x1E      /**< ELE latch, high-pass filtered X/Y/Z */
+#define ACCEL_TRANSIENT_SRC_EA    0x40      /**< Transient event active */
+
+#define ACCEL_THS_DBCNTM        0x80        /**< Debounce counter cleared as soon as the condition stops */
+#define ACCEL_THS_MG(mg)        ((uint8_t)(((mg) + 31) / 63)) /**< Threshold register value for @p mg milli-g */
 
 /* Measurement range selection */
 #define ACCEL_REG_XYZ_DATA_CFG  0x0E        /**< XYZ range configuration register */
@@ -36,6 +84,7 @@
 #define ACCEL_REG_OUT_Y_LSB     0x04        /**< Y-axis LSB */
 #define ACCEL_REG_OUT_Z_MSB     0x05        /**< Z-axis MSB */
 #define ACCEL_REG_OUT_Z_LSB     0x06        /**< Z-axis LSB */
+#define ACCEL_XYZ_SIZE          6           /**< Bytes of the X/Y/Z output burst */
 
 /**
  * @brief Initialize the accelerometer device.
@@ -62,6 +111,84 @@ int accel_init(const struct i2c_dt_spec *dev, uint8_t range);
  */
 int accel_read_xyz(const struct i2c_dt_spec *dev, int16_t *x, int16_t *y, int16_t *z);
 
+/**
+ * @brief Queue the X/Y/Z output burst in an I2C batch.
+ *
+ * Decode the buffer with @ref accel_decode_xyz() once the batch completes.
+ *
+ * @param batch Batch to add the transaction to.
+ * @param dev Pointer to the I2C device descriptor.
+ * @param buf Buffer of @ref ACCEL_XYZ_SIZE bytes, valid until the batch completes.
+ * @return The queued transaction, or NULL if the batch is full.
+ */
+struct i2c_batch_op *accel_queue_xyz(struct i2c_batch *batch, const struct i2c_dt_spec *dev,
+                                     uint8_t *buf);
+
+/**
+ * @brief Decode an X/Y/Z output burst into raw axis values.
+ *
+ * @param buf Buffer of @ref ACCEL_XYZ_SIZE bytes read from the output registers.
+ * @param x Pointer to store X-axis raw value.
+ * @param y Pointer to store Y-axis raw value.
+ * @param z Pointer to store Z-axis raw value.
+ */
+void accel_decode_xyz(const uint8_t *buf, int16_t *x, int16_t *y, int16_t *z);
+
+/**
+ * @brief Enable the FIFO in circular mode with a watermark interrupt on INT1.
+ *
+ * The INT1 pin is driven low while at least @p watermark samples are
+ * stored. Once enabled, the output registers read from the FIFO.
+ *
+ * @param dev Pointer to the I2C device descriptor.
+ * @param odr Output data rate (ACCEL_ODR_*).
+ * @param watermark Samples (1–32) that raise the interrupt.
+ * @return 0 on success, negative errno code on failure.
+ */
+int accel_fifo_enable(const struct i2c_dt_spec *dev, uint8_t odr, uint8_t watermark);
+
+/**
+ * @brief Enable the freefall and transient (shock) engines on INT1.
+ *
+ * Freefall: all three axes below @p ff_mg for @p ff_count samples.
+ * Transient: any high-pass filtered axis above @p shock_mg for
+ * @p shock_count samples. Both are latched until their source register
+ * is read. A threshold of 0 leaves the engine disabled.
+ *
+ * @param dev Pointer to the I2C device descriptor.
+ * @param ff_mg Freefall threshold (mg).
+ * @param ff_count Freefall debounce (samples at the configured ODR).
+ * @param shock_mg Transient threshold (mg).
+ * @param shock_count Transient debounce (samples at the configured ODR).
+ * @return 0 on success, negative errno code on failure.
+ */
+int accel_events_enable(const struct i2c_dt_spec *dev, uint16_t ff_mg, uint8_t ff_count,
+                        uint16_t shock_mg, uint8_t shock_count);
+
+/**
+ * @brief Queue a FIFO drain in an I2C batch.
+ *
+ * One burst reads F_STATUS followed by @p count samples: with the FIFO
+ * enabled the register pointer wraps from OUT_Z_LSB back to OUT_X_MSB.
+ *
+ * @param batch Batch to add the transaction to.
+ * @param dev Pointer to the I2C device descriptor.
+ * @param buf Buffer of 1 + @p count × @ref ACCEL_XYZ_SIZE bytes: F_STATUS,
+ *            then the samples to decode with @ref accel_decode_xyz().
+ * @param count Samples to read (1–32).
+ * @return The queued transaction, or NULL if the batch is full.
+ */
+struct i2c_batch_op *accel_queue_fifo(struct i2c_batch *batch, const struct i2c_dt_spec *dev,
+                                      uint8_t *buf, uint8_t count);
+
+/**
+ * @brief Sample period of an output data rate.
+ *
+ * @param odr Output data rate (ACCEL_ODR_*).
+ * @return Period between samples in microseconds.
+ */
+uint32_t accel_odr_period_us(uint8_t odr);
+
 /**
  * @brief Convert raw accelerometer value to g units.
  *
@@ -11,6 +11,8 @@
 #include <zephyr/kernel.h>
 #include <zephyr/sys/printk.h>
 
+static uint16_t integration_ms = 154; /**< Integration time (ms) of the configured ATIME. */
+
 /* === Internal helper functions === */
 
 /**
@@ -73,6 +75,7 @@ int color_init(const struct i2c_dt_spec *dev, uint8_t gain, uint8_t atime)
     /* Apply default settings */
     color_write_reg(dev, COLOR_CONTROL, gain);
     color_write_reg(dev, COLOR_ATIME, atime);
+    integration_ms = ((256 - atime) * 24 + 9) / 10; /* 2.4 ms per cycle */
 
     printk("[COLOR] - Color sensor initialized successfully\n");
     return 0;
@@ -142,3 +145,48 @@ int color_read_rgb(const struct i2c_dt_spec *dev, ColorSensorData *data)
 
     return 0;
 }
+
+int color_start(const struct i2c_dt_spec *dev)
+{
+    int ret = color_wake_up(dev);
+    if (ret < 0) {
+        printk("[COLOR SENSOR] - Failed to start integration (%d)\n", ret);
+        return ret;
+    }
+
+    /* The first cycle starts with a 2.4 ms RGBC initialization */
+    return integration_ms + 3;
+}
+
+int color_fetch(const struct i2c_dt_spec *dev, ColorSensorData *data)
+{
+    /* STATUS and the RGBC registers are contiguous: one burst */
+    uint8_t buf[1 + 8];
+    struct i2c_batch batch;
+
+    i2c_batch_init(&batch);
+    i2c_batch_read_regs(&batch, dev, COLOR_COMMAND | AUTO_INCREMENT | COLOR_STATUS, buf, sizeof(buf));
+
+    int ret = i2c_batch_submit(&batch);
+    if (ret == 0) ret = i2c_batch_wait(&batch);
+    if (ret < 0) {
+        printk("[COLOR SENSOR] - Failed to read RGB data (%d)\n", ret);
+        return ret;
+    }
+    if (!(buf[0] & STATUS_AVALID)) {
+        return -EBUSY;
+    }
+
+    uint16_t clear = (buf[2] << 8) | buf[1];
+
+    /* Avoid divide-by-zero */
+    if (clear == 0) clear = 1;
+
+    data->clear = clear;
+    data->red   = (buf[4] << 8) | buf[3];
+    data->green = (buf[6] << 8) | buf[5];
+    data->blue  = (buf[8] << 8) | buf[7];
+
+    color_sleep(dev);
+    return 0;
+}
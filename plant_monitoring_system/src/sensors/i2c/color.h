@@ -23,6 +23,7 @@
 #define COLOR_ENABLE      0x00  /**< Enable register */
 #define COLOR_ATIME       0x01  /**< Integration time register */
 #define COLOR_CONTROL     0x0F  /**< Gain control register */
+#define COLOR_STATUS      0x13  /**< Status register */
 #define COLOR_CLEAR_L     0x14  /**< Clear channel low byte */
 #define COLOR_RED_L       0x16  /**< Red channel low byte */
 #define COLOR_GREEN_L     0x18  /**< Green channel low byte */
@@ -32,6 +33,9 @@
 #define ENABLE_PON        0x01  /**< Power ON */
 #define ENABLE_AEN        0x02  /**< ADC Enable */
 
+/* === STATUS register bits === */
+#define STATUS_AVALID     0x01  /**< RGBC integration cycle completed */
+
 /* === Gain settings (CONTROL register) === */
 #define GAIN_1X           0x00  /**< 1x gain */
 #define GAIN_4X           0x01  /**< 4x gain */
@@ -90,4 +94,27 @@ int color_sleep(const struct i2c_dt_spec *dev);
  */
 int color_read_rgb(const struct i2c_dt_spec *dev, ColorSensorData *data);
 
+/**
+ * @brief Power the sensor up and start a fresh integration cycle.
+ *
+ * Collect the result with @ref color_fetch(), which puts the sensor back to
+ * sleep.
+ *
+ * @param dev Pointer to the I2C device descriptor.
+ * @return Time in ms until the integration completes, or a negative errno
+ *         code on failure.
+ */
+int color_start(const struct i2c_dt_spec *dev);
+
+/**
+ * @brief Collect the integration started by @ref color_start().
+ *
+ * @param dev Pointer to the I2C device descriptor.
+ * @param data Pointer to store the raw color values.
+ * @retval 0 On success; the sensor is back in sleep mode.
+ * @retval -EBUSY If the integration has not completed yet.
+ * @retval Negative errno code on bus failure.
+ */
+int color_fetch(const struct i2c_dt_spec *dev, ColorSensorData *data);
+
 #endif /* COLOR_H */
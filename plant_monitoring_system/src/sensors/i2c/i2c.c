@@ -8,7 +8,29 @@
  */
 
 #include "i2c.h"
+#include <zephyr/kernel.h>
 #include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+
+#ifdef CONFIG_I2C_RTIO
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#define I2C_RTIO_QUEUE_SIZE (2 * I2C_BATCH_MAX_OPS) /**< One SQE/CQE per message. */
+
+/*
+ * One RTIO context per batch in flight: a batch owner only consumes its own
+ * completions, so nothing has to be held between submission and wait.
+ */
+RTIO_DEFINE(i2c_rtio0, I2C_RTIO_QUEUE_SIZE, I2C_RTIO_QUEUE_SIZE);
+RTIO_DEFINE(i2c_rtio1, I2C_RTIO_QUEUE_SIZE, I2C_RTIO_QUEUE_SIZE);
+RTIO_DEFINE(i2c_rtio2, I2C_RTIO_QUEUE_SIZE, I2C_RTIO_QUEUE_SIZE);
+
+static struct rtio *const rtio_pool[I2C_BATCH_MAX_IN_FLIGHT] = { &i2c_rtio0, &i2c_rtio1, &i2c_rtio2 };
+static atomic_t rtio_free = ATOMIC_INIT(BIT_MASK(I2C_BATCH_MAX_IN_FLIGHT)); /**< Free contexts of the pool. */
+static K_SEM_DEFINE(rtio_avail, I2C_BATCH_MAX_IN_FLIGHT, I2C_BATCH_MAX_IN_FLIGHT);
+#endif
 
 /**
  * @brief Read multiple bytes from a device starting at a given register.
@@ -58,3 +80,227 @@ int i2c_dev_ready(const struct i2c_dt_spec *dev) {
     }
     return 0;
 }
+
+/* ---------------------------------------------------------------------------
+ * Batched transactions
+ * ---------------------------------------------------------------------------*/
+
+void i2c_batch_init(struct i2c_batch *batch)
+{
+    batch->count = 0;
+}
+
+/**
+ * @brief Reserve the next transaction of a batch.
+ */
+static struct i2c_batch_op *batch_add(struct i2c_batch *batch, const struct i2c_dt_spec *dev)
+{
+    if (batch->count >= I2C_BATCH_MAX_OPS) {
+        return NULL;
+    }
+
+    struct i2c_batch_op *op = &batch->ops[batch->count++];
+
+    op->dev = dev;
+    op->num_msgs = 0;
+    op->chained = false;
+    op->result = 0;
+    return op;
+}
+
+struct i2c_batch_op *i2c_batch_read_regs(struct i2c_batch *batch, const struct i2c_dt_spec *dev,
+                                         uint8_t reg, uint8_t *buf, size_t len)
+{
+    struct i2c_batch_op *op = batch_add(batch, dev);
+
+    if (op != NULL) {
+        op->reg = reg;
+        op->msgs[0] = (struct i2c_msg){ .buf = &op->reg, .len = 1, .flags = I2C_MSG_WRITE };
+        op->msgs[1] = (struct i2c_msg){ .buf = buf, .len = len,
+                                        .flags = I2C_MSG_READ | I2C_MSG_RESTART | I2C_MSG_STOP };
+        op->num_msgs = 2;
+    }
+    return op;
+}
+
+struct i2c_batch_op *i2c_batch_read(struct i2c_batch *batch, const struct i2c_dt_spec *dev,
+                                    uint8_t *buf, size_t len)
+{
+    struct i2c_batch_op *op = batch_add(batch, dev);
+
+    if (op != NULL) {
+        op->msgs[0] = (struct i2c_msg){ .buf = buf, .len = len,
+                                        .flags = I2C_MSG_READ | I2C_MSG_STOP };
+        op->num_msgs = 1;
+    }
+    return op;
+}
+
+#ifdef CONFIG_I2C_RTIO
+
+/**
+ * @brief Find the RTIO I/O device defined for an I2C device.
+ *
+ * I/O devices are defined at build time with @c I2C_IODEV_DEFINE(); the
+ * one with the same bus and address as @p dev is used.
+ */
+static struct rtio_iodev *iodev_get(const struct i2c_dt_spec *dev)
+{
+    STRUCT_SECTION_FOREACH(rtio_iodev, iodev) {
+        const struct i2c_dt_spec *spec = iodev->data;
+
+        if (iodev->api == &i2c_iodev_api && spec->bus == dev->bus && spec->addr == dev->addr) {
+            return iodev;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Take a free RTIO context for a batch, waiting if all are in flight.
+ */
+static struct rtio *rtio_claim(void)
+{
+    k_sem_take(&rtio_avail, K_FOREVER);
+
+    for (size_t i = 0; i < ARRAY_SIZE(rtio_pool); i++) {
+        if (atomic_test_and_clear_bit(&rtio_free, i)) {
+            return rtio_pool[i];
+        }
+    }
+    return NULL; /* Unreachable: the semaphore counts the free contexts */
+}
+
+/**
+ * @brief Return the RTIO context of a collected batch to the pool.
+ */
+static void rtio_release(struct rtio *r)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(rtio_pool); i++) {
+        if (rtio_pool[i] == r) {
+            atomic_set_bit(&rtio_free, i);
+            k_sem_give(&rtio_avail);
+            return;
+        }
+    }
+}
+
+int i2c_batch_submit(struct i2c_batch *batch)
+{
+    struct rtio *r = rtio_claim();
+    struct rtio_sqe *prev = NULL;
+
+    for (size_t i = 0; i < batch->count; i++) {
+        struct i2c_batch_op *op = &batch->ops[i];
+        struct rtio_iodev *iodev = iodev_get(op->dev);
+
+        if (iodev == NULL) {
+            rtio_sqe_drop_all(r);
+            rtio_release(r);
+            return -ENODEV;
+        }
+
+        /* A transaction only chains to the previous one when asked to */
+        if (prev != NULL && op->chained) {
+            prev->flags |= RTIO_SQE_CHAINED;
+        }
+
+        for (uint8_t m = 0; m < op->num_msgs; m++) {
+            const struct i2c_msg *msg = &op->msgs[m];
+            struct rtio_sqe *sqe = rtio_sqe_acquire(r);
+
+            if (sqe == NULL) {
+                rtio_sqe_drop_all(r);
+                rtio_release(r);
+                return -ENOMEM;
+            }
+
+            if (msg->flags & I2C_MSG_READ) {
+                rtio_sqe_prep_read(sqe, iodev, RTIO_PRIO_NORM, msg->buf, msg->len, op);
+            } else {
+                rtio_sqe_prep_write(sqe, iodev, RTIO_PRIO_NORM, msg->buf, msg->len, op);
+            }
+            if (msg->flags & I2C_MSG_RESTART) {
+                sqe->iodev_flags |= RTIO_IODEV_I2C_RESTART;
+            }
+            if (msg->flags & I2C_MSG_STOP) {
+                sqe->iodev_flags |= RTIO_IODEV_I2C_STOP;
+            }
+            if (m + 1 < op->num_msgs) {
+                sqe->flags |= RTIO_SQE_TRANSACTION;
+            }
+            prev = sqe;
+        }
+
+        op->pending = op->num_msgs;
+    }
+
+    int ret = rtio_submit(r, 0);
+    if (ret < 0) {
+        rtio_release(r);
+        return ret;
+    }
+
+    batch->rtio = r;
+    return 0;
+}
+
+int i2c_batch_wait(struct i2c_batch *batch)
+{
+    struct rtio *r = batch->rtio;
+    int ret = 0;
+
+    for (size_t i = 0; i < batch->count; i++) {
+        struct i2c_batch_op *op = &batch->ops[i];
+
+        /* One completion per message, in any order across transactions */
+        while (op->pending > 0) {
+            struct rtio_cqe *cqe = rtio_cqe_consume_block(r);
+            struct i2c_batch_op *done = cqe->userdata;
+
+            if (cqe->result < 0 && done->result == 0) {
+                done->result = cqe->result;
+            }
+            done->pending--;
+            rtio_cqe_release(r, cqe);
+        }
+
+        if (ret == 0) {
+            ret = op->result;
+        }
+    }
+
+    batch->rtio = NULL;
+    rtio_release(r);
+    return ret;
+}
+
+#else /* !CONFIG_I2C_RTIO */
+
+int i2c_batch_submit(struct i2c_batch *batch)
+{
+    for (size_t i = 0; i < batch->count; i++) {
+        struct i2c_batch_op *op = &batch->ops[i];
+
+        if (op->chained && i > 0 && batch->ops[i - 1].result < 0) {
+            op->result = -ECANCELED;
+        } else {
+            op->result = i2c_transfer_dt(op->dev, op->msgs, op->num_msgs);
+        }
+        op->pending = 0;
+    }
+
+    return 0;
+}
+
+int i2c_batch_wait(struct i2c_batch *batch)
+{
+    for (size_t i = 0; i < batch->count; i++) {
+        if (batch->ops[i].result < 0) {
+            return batch->ops[i].result;
+        }
+    }
+    return 0;
+}
+
+#endif /* CONFIG_I2C_RTIO */
@@ -12,8 +12,50 @@
 
 #include <zephyr/device.h>
 #include <zephyr/drivers/i2c.h>
+#include <stdbool.h>
 #include <stdint.h>
 
+/* --- Batched transactions --------------------------------------------------- */
+#define I2C_BATCH_MAX_OPS       4  /**< Transactions per batch. */
+#define I2C_BATCH_MAX_IN_FLIGHT 3  /**< Batches submitted and not yet collected (one per bus user). */
+
+struct rtio;
+
+/**
+ * @brief One I2C transaction (up to a register write + read) queued in a batch.
+ */
+struct i2c_batch_op {
+    const struct i2c_dt_spec *dev; /**< Target device. */
+    struct i2c_msg msgs[2];        /**< Messages of the transaction. */
+    uint8_t num_msgs;              /**< Number of messages used. */
+    uint8_t reg;                   /**< Register address sent by the write message. */
+    uint8_t pending;               /**< Completions still expected. */
+    bool chained;                  /**< Cancelled if the previous transaction failed. */
+    int result;                    /**< 0 on success, negative errno code on failure. */
+};
+
+/**
+ * @brief Set of transactions submitted to the bus together.
+ *
+ * Built with @ref i2c_batch_read_regs() / @ref i2c_batch_read(), started
+ * with @ref i2c_batch_submit() and collected with @ref i2c_batch_wait().
+ * With @c CONFIG_I2C_RTIO the batch goes through one RTIO submission queue
+ * and the caller is free until it waits for the completions; otherwise the
+ * transactions are executed by @ref i2c_batch_submit() itself. Every device
+ * used in a batch then needs an I/O device defined at build time with
+ * @c I2C_IODEV_DEFINE() for the same bus and address.
+ *
+ * Each batch in flight has its own RTIO context, so its owner only consumes
+ * its own completions and can do unrelated work between submission and wait
+ * without blocking other bus users. @ref i2c_batch_submit() only waits when
+ * @ref I2C_BATCH_MAX_IN_FLIGHT batches are already in flight.
+ */
+struct i2c_batch {
+    struct i2c_batch_op ops[I2C_BATCH_MAX_OPS]; /**< Queued transactions. */
+    size_t count;                               /**< Number of queued transactions. */
+    struct rtio *rtio;                          /**< RTIO context while in flight (CONFIG_I2C_RTIO). */
+};
+
 /**
  * @brief Read multiple bytes from a device register over I2C.
  *
@@ -50,4 +92,57 @@ int i2c_write_reg(const struct i2c_dt_spec *dev, uint8_t reg, uint8_t val);
  */
 int i2c_dev_ready(const struct i2c_dt_spec *dev);
 
+/**
+ * @brief Empty a batch.
+ *
+ * @param batch Batch to initialize.
+ */
+void i2c_batch_init(struct i2c_batch *batch);
+
+/**
+ * @brief Queue a burst read of @p len bytes starting at register @p reg.
+ *
+ * @param batch Batch to add the transaction to.
+ * @param dev Pointer to the I2C device descriptor.
+ * @param reg Register address to start reading.
+ * @param buf Buffer to store the data; must stay valid until the batch completes.
+ * @param len Number of bytes to read.
+ * @return The queued transaction, or NULL if the batch is full.
+ */
+struct i2c_batch_op *i2c_batch_read_regs(struct i2c_batch *batch, const struct i2c_dt_spec *dev,
+                                         uint8_t reg, uint8_t *buf, size_t len);
+
+/**
+ * @brief Queue a plain read (no register address) of @p len bytes.
+ *
+ * @param batch Batch to add the transaction to.
+ * @param dev Pointer to the I2C device descriptor.
+ * @param buf Buffer to store the data; must stay valid until the batch completes.
+ * @param len Number of bytes to read.
+ * @return The queued transaction, or NULL if the batch is full.
+ */
+struct i2c_batch_op *i2c_batch_read(struct i2c_batch *batch, const struct i2c_dt_spec *dev,
+                                    uint8_t *buf, size_t len);
+
+/**
+ * @brief Start the queued transactions.
+ *
+ * A transaction marked @c chained is cancelled (-ECANCELED) when the
+ * previous one fails. On success the batch must be collected with
+ * @ref i2c_batch_wait().
+ *
+ * @param batch Batch to submit.
+ * @return 0 on success, -ENODEV if a device has no RTIO I/O device,
+ *         negative errno code if the batch could not be queued.
+ */
+int i2c_batch_submit(struct i2c_batch *batch);
+
+/**
+ * @brief Wait for every transaction of a submitted batch.
+ *
+ * @param batch Submitted batch.
+ * @return 0 if every transaction succeeded, otherwise the first error.
+ */
+int i2c_batch_wait(struct i2c_batch *batch);
+
 #endif // I2C_H
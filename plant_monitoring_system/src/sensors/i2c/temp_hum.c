@@ -12,6 +12,8 @@
 #include <zephyr/sys/printk.h>
 #include <math.h>
 
+static uint8_t conversion_ms = 23; /**< Worst-case RH + temperature conversion time (ms) at the configured resolution. */
+
 /**
  * @brief Write a single command to the Si7021 sensor.
  *
@@ -73,16 +75,53 @@ int temp_hum_init(const struct i2c_dt_spec *dev, uint8_t resolution)
         return ret;
     }
 
+    /* RH conversion followed by the temperature conversion (datasheet maxima) */
+    switch (resolution) {
+    case TH_RES_RH8_TEMP12:  conversion_ms = 7;  break;
+    case TH_RES_RH10_TEMP13: conversion_ms = 11; break;
+    case TH_RES_RH11_TEMP11: conversion_ms = 10; break;
+    default:                 conversion_ms = 23; break;
+    }
+
     printk("[TEMP_HUM] - Resolution set successfully (0x%02X)\n", resolution);
     printk("[TEMP_HUM] - Initialization complete\n");
     return 0;
 }
 
+/**
+ * @brief Measure humidity and temperature, sleeping through the conversion.
+ *
+ * @param dev Pointer to a valid I2C device descriptor.
+ * @param humidity Pointer to store the relative humidity (%RH).
+ * @param temperature Pointer to store the temperature (°C).
+ * @return 0 on success, negative errno code on failure.
+ */
+static int temp_hum_measure_blocking(const struct i2c_dt_spec *dev, float *humidity, float *temperature)
+{
+    int ret = temp_hum_start(dev);
+    if (ret < 0) {
+        return ret;
+    }
+
+    k_msleep(ret);
+
+    for (int i = 0; i < TH_FETCH_RETRIES; i++) {
+        ret = temp_hum_fetch(dev, humidity, temperature);
+        if (ret != -EBUSY) {
+            return ret;
+        }
+        k_msleep(TH_FETCH_RETRY_MS);
+    }
+
+    return -ETIMEDOUT;
+}
+
 /**
  * @brief Read relative humidity from the temp_hum sensor.
  *
- * Uses the Hold Master mode to measure humidity and converts the raw value
- * to %RH using the formula from the datasheet.
+ * Uses the No Hold Master mode, so the bus is released during the
+ * conversion, and converts the raw value to %RH using the formula from
+ * the datasheet.
  *
  * @param dev Pointer to a valid I2C device descriptor.
  * @param humidity Pointer to float variable to store relative humidity (%RH).
@@ -90,28 +129,20 @@ int temp_hum_init(const struct i2c_dt_spec *dev, uint8_t resolution)
  */
 int temp_hum_read_humidity(const struct i2c_dt_spec *dev, float *humidity)
 {
-    uint8_t buf[2];
-    int ret = temp_hum_read_data(dev, TH_MEAS_RH_HOLD, buf, sizeof(buf));
+    float temperature;
+    int ret = temp_hum_measure_blocking(dev, humidity, &temperature);
     if (ret < 0) {
         printk("[TEMP_HUM] - Failed to read humidity (%d)\n", ret);
-        return ret;
     }
-
-    uint16_t raw_rh = ((uint16_t)buf[0] << 8) | buf[1];
-    float rh = ((125.0f * raw_rh) / 65536.0f) - 6.0f;
-
-    if (rh < 0.0f) rh = 0.0f;
-    if (rh > 100.0f) rh = 100.0f;
-
-    *humidity = rh;
-    return 0;
+    return ret;
 }
 
 /**
  * @brief Read temperature from the temp_hum sensor in degrees Celsius.
  *
- * Uses the Hold Master mode to measure temperature and converts the raw
- * value to °C using the formula from the datasheet.
+ * Uses the No Hold Master mode (the temperature converted with the RH
+ * measurement) and converts the raw value to °C using the formula from
+ * the datasheet.
  *
  * @param dev Pointer to a valid I2C device descriptor.
  * @param temperature Pointer to float variable to store temperature (°C).
@@ -119,16 +150,127 @@ int temp_hum_read_humidity(const struct i2c_dt_spec *dev, float *humidity)
  */
 int temp_hum_read_temperature(const struct i2c_dt_spec *dev, float *temperature)
 {
-    uint8_t buf[2];
-    int ret = temp_hum_read_data(dev, TH_MEAS_TEMP_HOLD, buf, sizeof(buf));
+    float humidity;
+    int ret = temp_hum_measure_blocking(dev, &humidity, temperature);
     if (ret < 0) {
         printk("[TEMP_HUM] - Failed to read temperature (%d)\n", ret);
+    }
+    return ret;
+}
+
+int temp_hum_start(const struct i2c_dt_spec *dev)
+{
+    int ret = temp_hum_write_cmd(dev, TH_MEAS_RH_NOHOLD);
+    if (ret < 0) {
+        printk("[TEMP_HUM] - Failed to start measurement (%d)\n", ret);
+        return ret;
+    }
+
+    return conversion_ms;
+}
+
+int temp_hum_fetch(const struct i2c_dt_spec *dev, float *humidity, float *temperature)
+{
+    uint8_t rh_buf[2], temp_buf[2];
+    struct i2c_batch batch;
+
+    /* RH result, then the temperature converted with it; the second read
+     * is chained so it is cancelled while the address is still NACKed */
+    i2c_batch_init(&batch);
+    i2c_batch_read(&batch, dev, rh_buf, sizeof(rh_buf));
+    i2c_batch_read_regs(&batch, dev, TH_READ_TEMP_FROM_RH, temp_buf, sizeof(temp_buf))->chained = true;
+
+    int ret = i2c_batch_submit(&batch);
+    if (ret < 0) {
         return ret;
     }
+    i2c_batch_wait(&batch);
+
+    if (batch.ops[0].result < 0) {
+        return -EBUSY; /* Conversion in progress */
+    }
+    if (batch.ops[1].result < 0) {
+        printk("[TEMP_HUM] - Failed to read temperature from RH (%d)\n", batch.ops[1].result);
+        return batch.ops[1].result;
+    }
+
+    uint16_t raw_rh = ((uint16_t)rh_buf[0] << 8) | rh_buf[1];
+    float rh = ((125.0f * raw_rh) / 65536.0f) - 6.0f;
 
-    uint16_t raw_temp = ((uint16_t)buf[0] << 8) | buf[1];
-    float temp = ((175.72f * raw_temp) / 65536.0f) - 46.85f;
+    if (rh < 0.0f) rh = 0.0f;
+    if (rh > 100.0f) rh = 100.0f;
 
-    *temperature = temp;
+    uint16_t raw_temp = ((uint16_t)temp_buf[0] << 8) | temp_buf[1];
+
+    *humidity = rh;
+    *temperature = ((175.72f * raw_temp) / 65536.0f) - 46.85f;
     return 0;
 }
+
+/* === Asynchronous measurement === */
+
+/**
+ * @brief Work handler: fetches the result, polling again if the sensor still NACKs.
+ */
+static void measurement_work_handler(struct k_work *work)
+{
+    struct temp_hum_measurement *m = CONTAINER_OF(work, struct temp_hum_measurement, work);
+
+    int ret = temp_hum_fetch(m->dev, &m->humidity, &m->temperature);
+    if (ret == -EBUSY && m->retries > 0) {
+        m->retries--;
+        k_timer_start(&m->timer, K_MSEC(TH_FETCH_RETRY_MS), K_NO_WAIT);
+        return;
+    }
+
+    m->result = (ret == -EBUSY) ? -ETIMEDOUT : ret;
+    k_sem_give(&m->done);
+}
+
+/**
+ * @brief Timer handler (interrupt context): defers the I2C fetch to the work queue.
+ */
+static void measurement_timer_handler(struct k_timer *timer)
+{
+    struct temp_hum_measurement *m = CONTAINER_OF(timer, struct temp_hum_measurement, timer);
+
+    k_work_submit(&m->work);
+}
+
+int temp_hum_measure_start(struct temp_hum_measurement *m, const struct i2c_dt_spec *dev)
+{
+    if (!m->initialized) {
+        k_timer_init(&m->timer, measurement_timer_handler, NULL);
+        k_work_init(&m->work, measurement_work_handler);
+        k_sem_init(&m->done, 0, 1);
+        m->initialized = true;
+    } else {
+        struct k_work_sync sync;
+
+        /* A measurement that timed out may still be in flight: keep its work
+         * from retrying, then flush it so it cannot complete the new one */
+        m->retries = 0;
+        k_timer_stop(&m->timer);
+        k_work_cancel_sync(&m->work, &sync);
+    }
+
+    k_sem_reset(&m->done);
+    m->dev = dev;
+    m->retries = TH_FETCH_RETRIES;
+
+    int ret = temp_hum_start(dev);
+    if (ret < 0) {
+        return ret;
+    }
+
+    k_timer_start(&m->timer, K_MSEC(ret), K_NO_WAIT);
+    return ret;
+}
+
+int temp_hum_measure_wait(struct temp_hum_measurement *m, k_timeout_t timeout)
+{
+    if (k_sem_take(&m->done, timeout) < 0) {
+        return -EAGAIN;
+    }
+    return m->result;
+}
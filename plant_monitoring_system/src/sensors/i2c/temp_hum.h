@@ -11,6 +11,8 @@
 
 #include <zephyr/device.h>
 #include <zephyr/drivers/i2c.h>
+#include <zephyr/kernel.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 /* === Si7021 I2C Configuration === */
@@ -21,6 +23,8 @@
 #define TH_READ_USER_REG       0xE7  /**< Read User Register 1 */
 #define TH_MEAS_RH_HOLD        0xE5  /**< Measure Relative Humidity, Hold Master mode */
 #define TH_MEAS_TEMP_HOLD      0xE3  /**< Measure Temperature, Hold Master mode */
+#define TH_MEAS_RH_NOHOLD      0xF5  /**< Measure Relative Humidity, No Hold Master mode */
+#define TH_MEAS_TEMP_NOHOLD    0xF3  /**< Measure Temperature, No Hold Master mode */
 #define TH_READ_TEMP_FROM_RH   0xE0  /**< Read Temperature from previous RH measurement */
 #define TH_RESET               0xFE  /**< Soft reset command */
 
@@ -29,6 +33,28 @@
 #define TH_RES_RH10_TEMP13   0x80  /**< RH:10-bit, Temp:13-bit */
 #define TH_RES_RH11_TEMP11   0x81  /**< RH:11-bit, Temp:11-bit */
 
+#define TH_FETCH_RETRY_MS    2     /**< Poll interval when a conversion outlasts its nominal time */
+#define TH_FETCH_RETRIES     25    /**< Polls before a conversion is reported as failed */
+
+/**
+ * @brief Asynchronous humidity/temperature measurement.
+ *
+ * A timer armed for the conversion time of the configured resolution
+ * submits a work item that fetches the result on the system work queue;
+ * the caller is free until it waits for @c done.
+ */
+struct temp_hum_measurement {
+    const struct i2c_dt_spec *dev; /**< Sensor being measured. */
+    struct k_timer timer;          /**< Expires when the conversion should be complete. */
+    struct k_work work;            /**< Fetches the result outside interrupt context. */
+    struct k_sem done;             /**< Given once the result (or an error) is available. */
+    float humidity;                /**< Relative humidity (%RH). */
+    float temperature;             /**< Temperature (°C). */
+    int result;                    /**< 0 on success, negative errno code on failure. */
+    uint8_t retries;               /**< Polls left if the sensor still NACKs. */
+    bool initialized;              /**< Kernel objects initialized. */
+};
+
 /* === Function Prototypes === */
 
 /**
@@ -45,7 +71,8 @@ int temp_hum_init(const struct i2c_dt_spec *dev, uint8_t resolution);
 /**
  * @brief Read temperature in degrees Celsius from the sensor.
  *
- * Performs a measurement and converts the raw data to °C.
+ * Performs a no-hold measurement, sleeping through the conversion, and
+ * converts the raw data to °C.
  *
  * @param dev Pointer to a valid I2C device descriptor.
  * @param temperature Pointer to store the temperature in °C.
@@ -56,7 +83,8 @@ int temp_hum_read_temperature(const struct i2c_dt_spec *dev, float *temperature)
 /**
  * @brief Read relative humidity in percent from the sensor.
  *
- * Performs a measurement and converts the raw data to %RH.
+ * Performs a no-hold measurement, sleeping through the conversion, and
+ * converts the raw data to %RH.
  *
  * @param dev Pointer to a valid I2C device descriptor.
  * @param humidity Pointer to store the relative humidity in %RH.
@@ -64,4 +92,55 @@ int temp_hum_read_temperature(const struct i2c_dt_spec *dev, float *temperature)
  */
 int temp_hum_read_humidity(const struct i2c_dt_spec *dev, float *humidity);
 
+/**
+ * @brief Start a humidity (and temperature) conversion without holding the bus.
+ *
+ * The Si7021 NACKs its address until the conversion completes, so the bus
+ * stays free for other devices meanwhile. Collect the result with
+ * @ref temp_hum_fetch().
+ *
+ * @param dev Pointer to a valid I2C device descriptor.
+ * @return Worst-case conversion time in ms for the configured resolution,
+ *         or a negative errno code on failure.
+ */
+int temp_hum_start(const struct i2c_dt_spec *dev);
+
+/**
+ * @brief Collect the conversion started by @ref temp_hum_start().
+ *
+ * @param dev Pointer to a valid I2C device descriptor.
+ * @param humidity Pointer to store the relative humidity in %RH.
+ * @param temperature Pointer to store the temperature in °C measured with it.
+ * @retval 0 On success.
+ * @retval -EBUSY If the conversion is still in progress.
+ * @retval Negative errno code if reading the temperature failed.
+ */
+int temp_hum_fetch(const struct i2c_dt_spec *dev, float *humidity, float *temperature);
+
+/**
+ * @brief Start an asynchronous measurement.
+ *
+ * Issues the no-hold command, so the bus stays free for the other sensors
+ * during the conversion, and arms a timer for the configured resolution's
+ * conversion time. The result is fetched from the system work queue.
+ * A previous measurement still in flight (after a timed-out wait) is
+ * cancelled first. Must not be called from the system work queue.
+ *
+ * @param m Measurement state (kept by the caller until completion).
+ * @param dev Pointer to a valid I2C device descriptor.
+ * @return Conversion time in ms, or a negative errno code on failure.
+ */
+int temp_hum_measure_start(struct temp_hum_measurement *m, const struct i2c_dt_spec *dev);
+
+/**
+ * @brief Wait for a measurement started with @ref temp_hum_measure_start().
+ *
+ * @param m Measurement state.
+ * @param timeout Maximum time to wait.
+ * @retval 0 On success; @c m->humidity and @c m->temperature are valid.
+ * @retval -EAGAIN If the measurement did not complete in time.
+ * @retval Negative errno code if the fetch failed.
+ */
+int temp_hum_measure_wait(struct temp_hum_measurement *m, k_timeout_t timeout);
+
 #endif /* TEMP_HUM_H */
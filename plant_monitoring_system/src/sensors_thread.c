@@ -6,6 +6,10 @@
  * acquiring data from multiple environmental sensors:
  * - **ADC sensors:** ambient brightness, soil moisture
  * - **I2C sensors:** temperature/humidity, accelerometer, RGB color
+ *
+ * Each sensor has its own period, phase and priority, and a small
+ * deadline-ordered min-heap decides which ones to sample next. Sensors due
+ * together are acquired as a pipeline that overlaps their conversion times.
  */
 
 #include "sensors_thread.h"
@@ -13,8 +17,15 @@
 #include "sensors/i2c/accel.h"
 #include "sensors/i2c/temp_hum.h"
 #include "sensors/i2c/color.h"
+#include "timekeeping.h"
+#include "channels.h"
 #include <zephyr/kernel.h>
 #include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+#include <stdbool.h>
+
+LOG_MODULE_REGISTER(sensors_thread, CONFIG_LOG_DEFAULT_LEVEL);
 
 /* --- Thread configuration --------------------------------------------------- */
 #define SENSORS_THREAD_STACK_SIZE 1024  /**< Stack size allocated for the sensors thread. */
@@ -28,111 +39,502 @@ static struct k_thread sensors_thread_data;                      /**< Thread con
  * ---------------------------------------------------------------------------*/
 
 /**
- * @brief Read an ADC sensor and store its value as a scaled percentage.
+ * @brief ADC channels due in the current batch.
+ *
+ * Their tasks queue them when the batch starts; the first one collected
+ * converts, in a single sequence, all the queued channels whose supply has
+ * settled, so probes sharing a switched supply are converted together once
+ * it settles.
+ */
+static struct {
+    const struct adc_config *cfgs[ADC_SCAN_MAX_CHANNELS]; /**< Queued channels. */
+    int32_t mv[ADC_SCAN_MAX_CHANNELS];                    /**< Voltages (mV), in queue order. */
+    int result[ADC_SCAN_MAX_CHANNELS];                    /**< Result of each conversion, 1 while pending. */
+    size_t count;                                         /**< Number of queued channels. */
+    bool converted;                                       /**< A conversion of this batch has run. */
+} adc_scan;
+
+/**
+ * @brief Queue an ADC channel in the scan of the current batch.
+ *
+ * @param cfg Pointer to the ADC configuration structure.
+ */
+static void adc_scan_add(const struct adc_config *cfg)
+{
+    if (adc_scan.converted) {
+        adc_scan.count = 0;
+        adc_scan.converted = false;
+    }
+    if (adc_scan.count < ADC_SCAN_MAX_CHANNELS) {
+        adc_scan.result[adc_scan.count] = 1;
+        adc_scan.cfgs[adc_scan.count++] = cfg;
+    }
+}
+
+/**
+ * @brief Converts the pending channels of the batch scan whose supply has settled.
+ */
+static void adc_scan_convert(void)
+{
+    const struct adc_config *cfgs[ADC_SCAN_MAX_CHANNELS];
+    int32_t mv[ADC_SCAN_MAX_CHANNELS];
+    size_t index[ADC_SCAN_MAX_CHANNELS];
+    size_t n = 0;
+
+    for (size_t i = 0; i < adc_scan.count; i++) {
+        if (adc_scan.result[i] > 0 && adc_power_settle_left(adc_scan.cfgs[i]->power) == 0) {
+            cfgs[n] = adc_scan.cfgs[i];
+            index[n++] = i;
+        }
+    }
+    if (n == 0) {
+        return;
+    }
+
+    int ret = adc_read_voltages(cfgs, n, mv);
+
+    for (size_t i = 0; i < n; i++) {
+        adc_scan.mv[index[i]] = mv[i];
+        adc_scan.result[index[i]] = ret;
+    }
+    adc_scan.converted = true;
+}
+
+/**
+ * @brief Read an ADC sensor from the batch scan as a scaled percentage.
  *
- * Converts a raw ADC reading to a percentage (×10 for one decimal precision).
+ * Converts the settled queued channels on first use, then scales the
+ * voltage of @p cfg to a percentage (×10 for one decimal precision).
  *
  * @param cfg Pointer to the ADC configuration structure.
- * @param target Pointer to the atomic variable where the scaled value will be stored.
+ * @param target Pointer to the sample field where the scaled value will be stored.
  * @param label Descriptive name of the sensor (for logging).
- * @param mv Pointer to store the measured voltage (in millivolts).
+ *
+ * @return 0 on success, negative error code otherwise (@p target is left unchanged).
  */
-static void read_adc_percentage(const struct adc_config *cfg, atomic_t *target,
-                                const char *label, int32_t *mv)
+static int read_adc_percentage(const struct adc_config *cfg, int32_t *target,
+                               const char *label)
 {
-    if (adc_read_voltage(cfg, mv) == 0) {
-        int32_t percent10 = ((*mv) * 1000) / cfg->vref_mv; /**< Scaled percentage ×10. */
-        atomic_set(target, percent10);
-    } else {
+    for (size_t i = 0; i < adc_scan.count; i++) {
+        if (adc_scan.cfgs[i] != cfg) {
+            continue;
+        }
+        if (adc_scan.result[i] > 0) {
+            /* The task's ready time covers the settling, up to the ms rounding */
+            k_msleep(adc_power_settle_left(cfg->power));
+            adc_scan_convert();
+        }
+        if (adc_scan.result[i] == 0) {
+            *target = (adc_scan.mv[i] * 1000) / cfg->vref_mv; /**< Scaled percentage ×10. */
+            return 0;
+        }
         printk("[ADC]: %s read error\n", label);
+        return adc_scan.result[i];
     }
+
+    printk("[ADC]: %s read error\n", label);
+    return -ENOENT;
 }
 
 /**
- * @brief Read accelerometer data and update the measurement structure.
+ * @brief Convert a raw accelerometer reading into the sample.
  *
- * Converts raw XYZ data into acceleration (m/s² ×100) and stores them atomically.
+ * Converts raw XYZ data into acceleration (m/s² ×100).
  *
- * @param dev Pointer to the accelerometer I2C device specification.
+ * @param raw Output burst read from the accelerometer.
  * @param range Accelerometer full-scale range setting.
- * @param x_ms2 Pointer to atomic variable for X-axis acceleration.
- * @param y_ms2 Pointer to atomic variable for Y-axis acceleration.
- * @param z_ms2 Pointer to atomic variable for Z-axis acceleration.
+ * @param sample Pointer to the @ref accel_sample being acquired.
  */
-static void read_accelerometer(const struct i2c_dt_spec *dev, uint8_t range,
-                               atomic_t *x_ms2, atomic_t *y_ms2, atomic_t *z_ms2) {
+static void convert_accelerometer(const uint8_t *raw, uint8_t range,
+                                  struct accel_sample *sample) {
     int16_t x_raw, y_raw, z_raw;
     float x_val, y_val, z_val;
 
-    if (accel_read_xyz(dev, &x_raw, &y_raw, &z_raw) == 0) {
-        accel_convert_to_ms2(x_raw, range, &x_val);
-        accel_convert_to_ms2(y_raw, range, &y_val);
-        accel_convert_to_ms2(z_raw, range, &z_val);
+    accel_decode_xyz(raw, &x_raw, &y_raw, &z_raw);
+    accel_convert_to_ms2(x_raw, range, &x_val);
+    accel_convert_to_ms2(y_raw, range, &y_val);
+    accel_convert_to_ms2(z_raw, range, &z_val);
 
-        atomic_set(x_ms2, (int32_t)(x_val * 100));
-        atomic_set(y_ms2, (int32_t)(y_val * 100));
-        atomic_set(z_ms2, (int32_t)(z_val * 100));
-    } else {
+    sample->x = (int32_t)(x_val * 100);
+    sample->y = (int32_t)(y_val * 100);
+    sample->z = (int32_t)(z_val * 100);
+}
+
+/* ---------------------------------------------------------------------------
+ * Sampling tasks
+ * ---------------------------------------------------------------------------*/
+
+#define FETCH_RETRY_MS   2   /**< Poll interval for a conversion that is not ready yet. */
+#define FETCH_TIMEOUT_MS 50  /**< Time given to a late conversion before giving up. */
+
+static struct env_sample env;     /**< Environment sample being built; a failed read keeps the previous value. */
+static struct accel_sample accel; /**< Latest accelerometer sample. */
+
+/** Brightness readings accumulated since the last @c env_chan publication. */
+static struct {
+    int64_t sum;
+    int32_t min;
+    int32_t max;
+    uint32_t count;
+} light_acc;
+
+/** @brief Queues the phototransistor in the batch ADC scan. */
+static int start_light(struct system_context *ctx)
+{
+    adc_scan_add(ctx->phototransistor);
+    return 0;
+}
+
+/** @brief Reads the brightness and adds it to the running mean. */
+static void sample_light(struct system_context *ctx)
+{
+    int32_t value;
+
+    if (read_adc_percentage(ctx->phototransistor, &value, "Brightness") == 0) {
+        light_acc.min = (light_acc.count == 0) ? value : MIN(light_acc.min, value);
+        light_acc.max = (light_acc.count == 0) ? value : MAX(light_acc.max, value);
+        light_acc.sum += value;
+        light_acc.count++;
+    }
+}
+
+/**
+ * @brief Powers the soil moisture probe and queues it in the batch ADC scan.
+ *
+ * @return Settle time of the probe supply (ms), or a negative error code.
+ */
+static int start_moisture(struct system_context *ctx)
+{
+    int ret = adc_power_get(ctx->soil_moisture->power);
+
+    if (ret >= 0) {
+        adc_scan_add(ctx->soil_moisture);
+    }
+    return ret;
+}
+
+/** @brief Reads the soil moisture into the environment sample and powers the probe down. */
+static void sample_moisture(struct system_context *ctx)
+{
+    if (read_adc_percentage(ctx->soil_moisture, &env.moisture, "Moisture") == 0) {
+        env.moisture_min = env.moisture;
+        env.moisture_max = env.moisture;
+    }
+    adc_power_put(ctx->soil_moisture->power);
+}
+
+static struct i2c_batch accel_batch;      /**< Accelerometer burst in flight. */
+static uint8_t accel_raw[ACCEL_XYZ_SIZE]; /**< Destination of the accelerometer burst. */
+
+/** @brief Queues the accelerometer burst; the bus runs it while the ADC is read. */
+static int start_accel(struct system_context *ctx)
+{
+    i2c_batch_init(&accel_batch);
+    accel_queue_xyz(&accel_batch, ctx->accelerometer, accel_raw);
+
+    int ret = i2c_batch_submit(&accel_batch);
+    if (ret < 0) {
+        printk("[ACCELEROMETER] - Error queuing read (%d)\n", ret);
+        return ret;
+    }
+
+    accel.timestamp = timekeeping_now();
+    return 0;
+}
+
+/** @brief Collects the accelerometer burst and publishes the sample on @c accel_chan. */
+static void collect_accel(struct system_context *ctx)
+{
+    if (i2c_batch_wait(&accel_batch) < 0) {
         printk("[ACCELEROMETER] - Error reading accelerometer\n");
+        return;
+    }
+
+    convert_accelerometer(accel_raw, ctx->accel_range, &accel);
+    zbus_chan_pub(&accel_chan, &accel, CHANNEL_TIMEOUT);
+}
+
+static struct temp_hum_measurement th_meas; /**< Si7021 measurement completed by its timer. */
+
+/** @brief Starts a no-hold humidity and temperature conversion. */
+static int start_temp_hum(struct system_context *ctx)
+{
+    return temp_hum_measure_start(&th_meas, ctx->temp_hum);
+}
+
+/**
+ * @brief Collects the humidity and temperature conversion into the environment sample.
+ *
+ * The result has normally been fetched by the measurement timer already.
+ * Both values are scaled ×100.
+ */
+static void collect_temp_hum(struct system_context *ctx)
+{
+    ARG_UNUSED(ctx);
+
+    int ret = temp_hum_measure_wait(&th_meas,
+                                    K_MSEC(TH_FETCH_RETRIES * TH_FETCH_RETRY_MS + FETCH_TIMEOUT_MS));
+
+    if (ret == 0) {
+        env.hum  = (int32_t)(th_meas.humidity * 100);
+        env.temp = (int32_t)(th_meas.temperature * 100);
+    } else {
+        printk("[TEMP_HUM SENSOR] - Read error (%d)\n", ret);
     }
 }
 
+/** @brief Powers the color sensor up for one integration cycle. */
+static int start_color(struct system_context *ctx)
+{
+    return color_start(ctx->color);
+}
+
+/** @brief Collects the raw RGB and clear channels into the environment sample. */
+static void collect_color(struct system_context *ctx)
+{
+    ColorSensorData color_data;
+    int64_t give_up = k_uptime_get() + FETCH_TIMEOUT_MS;
+    int ret;
+
+    while ((ret = color_fetch(ctx->color, &color_data)) == -EBUSY &&
+           k_uptime_get() < give_up) {
+        k_msleep(FETCH_RETRY_MS);
+    }
+
+    if (ret == 0) {
+        env.red   = color_data.red;
+        env.green = color_data.green;
+        env.blue  = color_data.blue;
+        env.clear = color_data.clear;
+    } else {
+        color_sleep(ctx->color);
+        printk("[COLOR SENSOR] - Read error (%d)\n", ret);
+    }
+}
+
+/**
+ * @brief Copies the continuous-mode statistics of one channel into the sample.
+ *
+ * Leaves the previous values when no block was reduced in the interval.
+ *
+ * @param ctx System context holding the stream.
+ * @param stats Statistics taken from the stream, in the order of its channels.
+ * @param cfg Channel to copy.
+ * @param mean, min, max Sample fields (% ×10).
+ */
+static void apply_adc_stats(const struct system_context *ctx, const struct adc_stats *stats,
+                            const struct adc_config *cfg,
+                            int32_t *mean, int32_t *min, int32_t *max)
+{
+    for (size_t i = 0; i < ctx->adc_stream->count; i++) {
+        if (ctx->adc_stream->cfgs[i] == cfg && stats[i].blocks > 0) {
+            *mean = (stats[i].mean_mv * 1000) / cfg->vref_mv;
+            *min  = (stats[i].min_mv * 1000) / cfg->vref_mv;
+            *max  = (stats[i].max_mv * 1000) / cfg->vref_mv;
+        }
+    }
+}
 
 /**
- * @brief Read temperature and humidity data.
+ * @brief Publishes the environment sample with the brightness statistics since the last publication.
  *
- * Reads relative humidity first (which triggers a temperature measurement internally),
- * then retrieves the corresponding temperature. Both values are scaled ×100.
+ * In continuous mode, brightness and soil moisture come from the ADC
+ * stream's statistics over the same interval.
+ */
+static void publish_env(struct system_context *ctx)
+{
+    if (ctx->adc_stream != NULL) {
+        struct adc_stats stats[ADC_SCAN_MAX_CHANNELS];
+
+        adc_stream_take(ctx->adc_stream, stats);
+        apply_adc_stats(ctx, stats, ctx->phototransistor,
+                        &env.brightness, &env.brightness_min, &env.brightness_max);
+        apply_adc_stats(ctx, stats, ctx->soil_moisture,
+                        &env.moisture, &env.moisture_min, &env.moisture_max);
+    } else if (light_acc.count > 0) {
+        env.brightness = (int32_t)(light_acc.sum / light_acc.count);
+        env.brightness_min = light_acc.min;
+        env.brightness_max = light_acc.max;
+        light_acc.sum = 0;
+        light_acc.count = 0;
+    }
+
+    env.timestamp = timekeeping_now();
+    zbus_chan_pub(&env_chan, &env, CHANNEL_TIMEOUT);
+}
+
+/* ---------------------------------------------------------------------------
+ * Deadline scheduler
+ * ---------------------------------------------------------------------------*/
+
+/**
+ * @brief Periodic job of the sensors thread.
  *
- * @param dev Pointer to the temperature/humidity I2C device specification.
- * @param temp Pointer to atomic variable for temperature (°C ×100).
- * @param hum Pointer to atomic variable for relative humidity (%RH ×100).
+ * A sensor with a conversion time is split in two: @c start triggers the
+ * conversion and @c collect reads the result once it is ready, so the other
+ * sensors of the batch are read meanwhile.
  */
-static void read_temperature_humidity(const struct i2c_dt_spec *dev,
-                                      atomic_t *temp, atomic_t *hum) {
+struct sensor_task {
+    int (*start)(struct system_context *ctx);    /**< Starts a conversion, returns ms until ready (NULL if immediate). */
+    void (*collect)(struct system_context *ctx); /**< Reads the sensor. */
+    int64_t deadline;                            /**< Next run (uptime, ms). */
+    int64_t ready;                               /**< Uptime the result is ready in the current batch, -1 if start failed. */
+    uint32_t period_ms;                          /**< Interval between runs (ms). */
+    uint8_t priority;                            /**< Order among tasks ready at the same time (lower = first). */
+    bool adc;                                    /**< Queued in the batch ADC scan. */
+    bool last;                                   /**< Collected after the rest of its batch. */
+};
+
+static struct sensor_task tasks[SENSOR_COUNT + 1] = {
+    [SENSOR_LIGHT]    = { .start = start_light, .collect = sample_light, .adc = true },
+    [SENSOR_MOISTURE] = { .start = start_moisture, .collect = sample_moisture, .adc = true },
+    [SENSOR_ACCEL]    = { .start = start_accel, .collect = collect_accel },
+    [SENSOR_TEMP_HUM] = { .start = start_temp_hum, .collect = collect_temp_hum },
+    [SENSOR_COLOR]    = { .start = start_color, .collect = collect_color },
+    [SENSOR_COUNT]    = { .collect = publish_env, .priority = UINT8_MAX, .last = true },
+};
+
+/** Min-heap of the enabled tasks, ordered by deadline then priority. */
+static struct sensor_task *heap[ARRAY_SIZE(tasks)];
+static size_t heap_len;
+
+static bool task_before(const struct sensor_task *a, const struct sensor_task *b)
+{
+    return a->deadline < b->deadline ||
+           (a->deadline == b->deadline && a->priority < b->priority);
+}
+
+static void heap_swap(size_t i, size_t j)
+{
+    struct sensor_task *tmp = heap[i];
+
+    heap[i] = heap[j];
+    heap[j] = tmp;
+}
+
+static void heap_push(struct sensor_task *task)
+{
+    size_t i = heap_len++;
 
-    float humidity;
+    heap[i] = task;
+    while (i > 0 && task_before(heap[i], heap[(i - 1) / 2])) {
+        heap_swap(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
 
-    if (temp_hum_read_humidity(dev, &humidity) == 0) {
-        float temperature;  // ahora solo existe dentro del bloque if
+static void heap_sift_down(size_t i)
+{
+    while (1) {
+        size_t first = i;
+        size_t left = 2 * i + 1;
+        size_t right = left + 1;
 
-        uint8_t buf[2];
-        int ret = i2c_write_read_dt(dev, (uint8_t[]){ TH_READ_TEMP_FROM_RH }, 1, buf, 2);
-        if (ret == 0) {
-            uint16_t raw_temp = ((uint16_t)buf[0] << 8) | buf[1];
-            temperature = ((175.72f * raw_temp) / 65536.0f) - 46.85f;
-        } else {
-            printk("[TEMP_HUM SENSOR] - Error reading temperature from RH (%d)\n", ret);
+        if (left < heap_len && task_before(heap[left], heap[first])) {
+            first = left;
+        }
+        if (right < heap_len && task_before(heap[right], heap[first])) {
+            first = right;
+        }
+        if (first == i) {
             return;
         }
+        heap_swap(i, first);
+        i = first;
+    }
+}
 
-        atomic_set(hum,  (int32_t)(humidity * 100));
-        atomic_set(temp, (int32_t)(temperature * 100));
+static struct sensor_task *heap_pop(void)
+{
+    struct sensor_task *top = heap[0];
 
-    } else {
-        printk("[TEMP_HUM SENSOR] - Read error (humidity)\n");
-    }
+    heap[0] = heap[--heap_len];
+    heap_sift_down(0);
+    return top;
 }
 
 /**
- * @brief Read RGB color sensor and update measurement structure.
+ * @brief Acquires every task due at @p now as one pipeline.
  *
- * Reads raw RGB and clear channel values from the color sensor and updates
- * the shared measurement structure atomically.
+ * All conversions are started first; then the tasks are collected in the
+ * order their results become ready, so the immediate reads (ADC, and the
+ * accelerometer burst queued on the I2C bus) happen while the Si7021 and
+ * TCS34725 convert and the batch takes about as long as its slowest sensor.
+ * The ADC tasks share the ready time of their slowest channel, so a
+ * channel that is ready at once waits for a switched supply to settle and
+ * all of them are converted in one sequence within one power window.
  *
- * @param dev Pointer to the color sensor I2C device specification.
- * @param measure Pointer to the shared @ref system_measurement structure.
+ * @param ctx Pointer to the shared @ref system_context structure.
+ * @param now Current uptime (ms).
  */
-static void read_color_sensor(const struct i2c_dt_spec *dev, struct system_measurement *measure) {
-    ColorSensorData color_data;
+static void run_batch(struct system_context *ctx, int64_t now)
+{
+    struct sensor_task *batch[ARRAY_SIZE(tasks)];
+    size_t n = 0;
+    int64_t latest = now;
+    int64_t adc_ready = -1;
+    uint32_t begin = k_cycle_get_32();
 
-    if (color_read_rgb(dev, &color_data) == 0) {
-        atomic_set(&measure->red,   color_data.red);
-        atomic_set(&measure->green, color_data.green);
-        atomic_set(&measure->blue,  color_data.blue);
-        atomic_set(&measure->clear, color_data.clear);
-    } else {
-        printk("[COLOR SENSOR] - Read error\n");
+    while (heap_len > 0 && heap[0]->deadline <= now) {
+        batch[n++] = heap_pop();
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        struct sensor_task *task = batch[i];
+        int ret = task->start ? task->start(ctx) : 0;
+
+        task->ready = (ret < 0) ? -1 : now + ret;
+        latest = MAX(latest, task->ready);
+        if (task->adc) {
+            adc_ready = MAX(adc_ready, task->ready);
+        }
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        if (batch[i]->adc && batch[i]->ready >= 0) {
+            batch[i]->ready = adc_ready;
+        }
+    }
+
+    /* Sort by ready time, then priority (insertion sort: a handful of tasks) */
+    for (size_t i = 0; i < n; i++) {
+        struct sensor_task *task = batch[i];
+        size_t j = i;
+
+        if (task->last) {
+            task->ready = latest;
+        }
+        while (j > 0 && (batch[j - 1]->ready > task->ready ||
+                         (batch[j - 1]->ready == task->ready &&
+                          batch[j - 1]->priority > task->priority))) {
+            batch[j] = batch[j - 1];
+            j--;
+        }
+        batch[j] = task;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        struct sensor_task *task = batch[i];
+
+        if (task->ready >= 0) {
+            k_sleep(K_TIMEOUT_ABS_MS(task->ready));
+            task->collect(ctx);
+        }
+    }
+
+    LOG_DBG("Acquired %u tasks in %u us", (unsigned int)n,
+            k_cyc_to_us_floor32(k_cycle_get_32() - begin));
+
+    /* Reschedule, skipping the periods an overrun missed */
+    now = k_uptime_get();
+    for (size_t i = 0; i < n; i++) {
+        struct sensor_task *task = batch[i];
+
+        task->deadline += task->period_ms;
+        if (task->deadline <= now) {
+            task->deadline += ((now - task->deadline) / task->period_ms + 1) * task->period_ms;
+        }
+        heap_push(task);
     }
 }
 
@@ -143,31 +545,39 @@ static void read_color_sensor(const struct i2c_dt_spec *dev, struct system_measu
 /**
  * @brief Main function for the sensors measurement thread.
  *
- * This thread continuously monitors the system mode and performs ADC and I2C
- * sensor readings when appropriate. The results are stored in the shared
- * @ref system_measurement structure.
+ * Samples every sensor on its own schedule
+ * (@ref system_context::sensors): the thread sleeps until the earliest
+ * deadline and acquires every task due by then as one pipelined batch
+ * (see @ref run_batch()). Accelerometer samples are published on
+ * @c accel_chan as they are taken; the environment sample is published on
+ * @c env_chan every @ref system_context::sensors_period_ms with the mean
+ * brightness and the latest value of the slower sensors.
  *
  * @param arg1 Pointer to the shared @ref system_context structure.
- * @param arg2 Pointer to the shared @ref system_measurement structure.
+ * @param arg2 Unused (set to NULL).
  * @param arg3 Unused (set to NULL).
  */
 static void sensors_thread_fn(void *arg1, void *arg2, void *arg3) {
     struct system_context *ctx = (struct system_context *)arg1;
-    struct system_measurement *measure = (struct system_measurement *)arg2;
+    int64_t start = k_uptime_get();
 
-    int32_t mv = 0;
-
-    while (1) {
-        k_sem_take(ctx->sensors_sem, K_FOREVER);
+    for (int i = 0; i < SENSOR_COUNT; i++) {
+        tasks[i].period_ms = ctx->sensors[i].period_ms;
+        tasks[i].priority = ctx->sensors[i].priority;
+        tasks[i].deadline = start + ctx->sensors[i].phase_ms;
+    }
+    tasks[SENSOR_COUNT].period_ms = ctx->sensors_period_ms;
+    tasks[SENSOR_COUNT].deadline = start;
 
-        read_adc_percentage(ctx->phototransistor, &measure->brightness, "Brightness", &mv);
-        read_adc_percentage(ctx->soil_moisture, &measure->moisture, "Moisture", &mv);
-        read_accelerometer(ctx->accelerometer, ctx->accel_range,
-                                   &measure->accel_x, &measure->accel_y, &measure->accel_z);
-        read_temperature_humidity(ctx->temp_hum, &measure->temp, &measure->hum);
-        read_color_sensor(ctx->color, measure);
+    for (size_t i = 0; i < ARRAY_SIZE(tasks); i++) {
+        if (tasks[i].period_ms > 0) {
+            heap_push(&tasks[i]);
+        }
+    }
 
-        k_sem_give(ctx->main_sensors_sem);
+    while (heap_len > 0) {
+        k_sleep(K_TIMEOUT_ABS_MS(heap[0]->deadline));
+        run_batch(ctx, k_uptime_get());
     }
 }
 
@@ -178,18 +588,16 @@ static void sensors_thread_fn(void *arg1, void *arg2, void *arg3) {
 /**
  * @brief Start the sensors measurement thread.
  *
- * Initializes synchronization primitives and creates the Zephyr thread
- * that handles periodic sensor data acquisition.
+ * Creates the Zephyr thread that handles periodic sensor data acquisition.
  *
  * @param ctx Pointer to the shared @ref system_context structure.
- * @param measure Pointer to the shared @ref system_measurement structure.
  */
-void start_sensors_thread(struct system_context *ctx, struct system_measurement *measure) {
+void start_sensors_thread(struct system_context *ctx) {
     k_thread_create(&sensors_thread_data,
                     sensors_stack,
                     K_THREAD_STACK_SIZEOF(sensors_stack),
                     sensors_thread_fn,
-                    ctx, measure, NULL,
+                    ctx, NULL, NULL,
                     SENSORS_THREAD_PRIORITY, 0, K_NO_WAIT);
 
     k_thread_name_set(&sensors_thread_data, "sensors_thread");
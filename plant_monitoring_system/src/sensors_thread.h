@@ -19,15 +19,15 @@
 /**
  * @brief Start the sensors measurement thread.
  *
- * Initializes synchronization primitives (timer, semaphores) and launches a
- * dedicated Zephyr thread that periodically samples sensors and stores the
- * results into the provided @ref system_measurement structure.
+ * Launches a dedicated Zephyr thread that samples each sensor on its own
+ * schedule (@ref system_context::sensors), publishes accelerometer samples
+ * on @c accel_chan as they are taken and the environment sample on
+ * @c env_chan every @ref system_context::sensors_period_ms.
  *
  * The function does not block; the thread runs asynchronously.
  *
- * @param ctx Pointer to a valid @ref system_context containing configuration and semaphores.
- * @param measure Pointer to a valid @ref system_measurement where sensor values will be stored.
+ * @param ctx Pointer to a valid @ref system_context containing the sensor configuration.
  */
-void start_sensors_thread(struct system_context *ctx, struct system_measurement *measure);
+void start_sensors_thread(struct system_context *ctx);
 
 #endif /* SENSORS_THREAD_H */
@@ -0,0 +1,207 @@
+/**
+ * @file timekeeping.c
+ * @brief Unix-epoch wall clock disciplined from GPS and network time.
+ *
+ * ## Features:
+ * - Clock kept as the last synchronization point and extrapolated with
+ *   k_uptime, so reading it costs no peripheral access
+ * - Source priority: network time does not override a recent GPS time
+ * - Drift of the uptime oscillator measured between GPS synchronizations
+ *   at least @ref TIMEKEEPING_DRIFT_MIN_INTERVAL_MS apart and compensated (in ppm)
+ * - Calendar conversions without the C library time functions
+ */
+
+#include "timekeeping.h"
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/util.h>
+#include <errno.h>
+#include <stdlib.h>
+
+/* --- Clock configuration ---------------------------------------------------- */
+#define TIMEKEEPING_MIN_YEAR               2024                  /**< Earlier dates are receiver defaults or week rollovers. */
+#define TIMEKEEPING_HOLDOVER_MS            (24 * 60 * 60 * 1000) /**< Time a better source keeps precedence after its last sync. */
+#define TIMEKEEPING_DRIFT_MIN_INTERVAL_MS  (10 * 60 * 1000)      /**< Minimum interval between GPS syncs used to measure drift. */
+#define TIMEKEEPING_DRIFT_MAX_PPM          500                   /**< Larger measured drifts are treated as time steps. */
+#define TIMEKEEPING_DRIFT_GAIN             4                     /**< Smoothing divisor applied to each drift measurement. */
+
+/**
+ * @brief Wall-clock state.
+ *
+ * Unix time at uptime @c t is
+ * base_unix_ms + (t - base_uptime) * (1 + drift_ppm / 1e6).
+ */
+static struct {
+    enum timekeeping_source source; /**< Source of the last synchronization. */
+    int64_t base_unix_ms;           /**< Unix time of the last synchronization (ms). */
+    int64_t base_uptime;            /**< Uptime of the last synchronization (ms). */
+    int32_t drift_ppm;              /**< Estimated uptime oscillator error (ppm, positive = slow). */
+
+    bool ref_valid;                 /**< Whether a GPS drift reference is set. */
+    int64_t ref_unix_ms;            /**< Unix time of the drift reference (ms). */
+    int64_t ref_uptime;             /**< Uptime of the drift reference (ms). */
+} clk;
+
+static struct k_spinlock clk_lock; /**< Guards @ref clk (read from every thread). */
+
+/* ---------------------------------------------------------------------------
+ * Calendar conversions
+ * ---------------------------------------------------------------------------*/
+
+/**
+ * @brief Days since 1970-01-01 of a proleptic Gregorian date.
+ */
+static int64_t days_from_civil(int32_t y, uint32_t m, uint32_t d)
+{
+    y -= (m <= 2);
+    int32_t era = (y >= 0 ? y : y - 399) / 400;
+    uint32_t yoe = (uint32_t)(y - era * 400);
+    uint32_t doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+    return (int64_t)era * 146097 + (int64_t)doe - 719468;
+}
+
+int timekeeping_utc_to_unix(const struct gps_utc *utc, int64_t *unix_ms)
+{
+    if (!utc || !unix_ms || utc->year == 0 ||
+        utc->month < 1 || utc->month > 12 || utc->day < 1 || utc->day > 31 ||
+        utc->hour > 23 || utc->minute > 59 || utc->second > 60 || utc->msec > 999) {
+        return -EINVAL;
+    }
+
+    int64_t days = days_from_civil(utc->year, utc->month, utc->day);
+    int64_t secs = days * 86400 + utc->hour * 3600 + utc->minute * 60 + utc->second;
+
+    *unix_ms = secs * 1000 + utc->msec;
+    return 0;
+}
+
+void timekeeping_epoch_to_utc(uint32_t epoch, struct gps_utc *utc)
+{
+    uint32_t days = epoch / 86400;
+    uint32_t rem = epoch % 86400;
+
+    /* Inverse of days_from_civil() for non-negative days */
+    uint32_t z = days + 719468;
+    uint32_t era = z / 146097;
+    uint32_t doe = z - era * 146097;
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    uint32_t mp = (5 * doy + 2) / 153;
+    uint32_t m = mp < 10 ? mp + 3 : mp - 9;
+
+    utc->year = (uint16_t)(yoe + era * 400 + (m <= 2));
+    utc->month = (uint8_t)m;
+    utc->day = (uint8_t)(doy - (153 * mp + 2) / 5 + 1);
+    utc->hour = (uint8_t)(rem / 3600);
+    utc->minute = (uint8_t)((rem / 60) % 60);
+    utc->second = (uint8_t)(rem % 60);
+    utc->msec = 0;
+}
+
+/* ---------------------------------------------------------------------------
+ * Clock discipline
+ * ---------------------------------------------------------------------------*/
+
+/**
+ * @brief Unix time (ms) at an uptime instant; caller holds @ref clk_lock.
+ */
+static int64_t clock_unix_ms_at(int64_t uptime)
+{
+    int64_t elapsed = uptime - clk.base_uptime;
+
+    return clk.base_unix_ms + elapsed + (elapsed * clk.drift_ppm) / 1000000;
+}
+
+/**
+ * @brief Updates the drift estimate from a GPS synchronization.
+ *
+ * Caller holds @ref clk_lock.
+ */
+static void clock_measure_drift(int64_t unix_ms, int64_t uptime)
+{
+    if (clk.ref_valid) {
+        int64_t elapsed = uptime - clk.ref_uptime;
+        if (elapsed < TIMEKEEPING_DRIFT_MIN_INTERVAL_MS) return;
+
+        int64_t error = (unix_ms - clk.ref_unix_ms) - elapsed;
+        int32_t ppm = (int32_t)((error * 1000000) / elapsed);
+
+        if (abs(ppm) <= TIMEKEEPING_DRIFT_MAX_PPM) {
+            clk.drift_ppm += (ppm - clk.drift_ppm) / TIMEKEEPING_DRIFT_GAIN;
+        }
+    }
+
+    clk.ref_unix_ms = unix_ms;
+    clk.ref_uptime = uptime;
+    clk.ref_valid = true;
+}
+
+int timekeeping_sync(int64_t unix_ms, int64_t uptime, enum timekeeping_source source)
+{
+    static const char *const names[] = { "none", "network", "GPS" };
+    struct gps_utc min_date = { .year = TIMEKEEPING_MIN_YEAR, .month = 1, .day = 1 };
+    int64_t min_unix_ms;
+    int64_t step = 0;
+    bool first;
+
+    timekeeping_utc_to_unix(&min_date, &min_unix_ms);
+    if (source == TIMEKEEPING_SOURCE_NONE || unix_ms < min_unix_ms) return -EINVAL;
+
+    k_spinlock_key_t key = k_spin_lock(&clk_lock);
+
+    if (clk.source > source && uptime - clk.base_uptime < TIMEKEEPING_HOLDOVER_MS) {
+        k_spin_unlock(&clk_lock, key);
+        return -EALREADY;
+    }
+
+    first = (clk.source == TIMEKEEPING_SOURCE_NONE);
+    if (!first) step = unix_ms - clock_unix_ms_at(uptime);
+
+    if (source == TIMEKEEPING_SOURCE_GPS) clock_measure_drift(unix_ms, uptime);
+
+    clk.source = source;
+    clk.base_unix_ms = unix_ms;
+    clk.base_uptime = uptime;
+
+    int32_t drift = clk.drift_ppm;
+    k_spin_unlock(&clk_lock, key);
+
+    /* Only log the first sync and real corrections, not every GPS epoch */
+    if (first || step > 1000 || step < -1000) {
+        printk("[TIME] - Clock set from %s: epoch %u (step %d ms, drift %d ppm)\n",
+               names[source], (uint32_t)(unix_ms / 1000),
+               (int32_t)CLAMP(step, INT32_MIN, INT32_MAX), drift);
+    }
+    return 0;
+}
+
+int timekeeping_sync_utc(const struct gps_utc *utc, int64_t uptime, enum timekeeping_source source)
+{
+    int64_t unix_ms;
+
+    int ret = timekeeping_utc_to_unix(utc, &unix_ms);
+    if (ret < 0) return ret;
+
+    return timekeeping_sync(unix_ms, uptime, source);
+}
+
+uint32_t timekeeping_epoch_at(int64_t uptime)
+{
+    uint32_t epoch = TIMEKEEPING_EPOCH_UNKNOWN;
+
+    k_spinlock_key_t key = k_spin_lock(&clk_lock);
+    if (clk.source != TIMEKEEPING_SOURCE_NONE) {
+        epoch = (uint32_t)(clock_unix_ms_at(uptime) / 1000);
+    }
+    k_spin_unlock(&clk_lock, key);
+
+    return epoch;
+}
+
+uint32_t timekeeping_now(void)
+{
+    return timekeeping_epoch_at(k_uptime_get());
+}
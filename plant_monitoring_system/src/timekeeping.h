@@ -0,0 +1,95 @@
+/**
+ * @file timekeeping.h
+ * @brief Unix-epoch wall clock disciplined from GPS and network time.
+ *
+ * The clock is kept as a reference pair (Unix time, uptime) and is
+ * extrapolated with k_uptime between synchronizations, corrected by the
+ * measured drift of the uptime oscillator. GPS RMC date/time (ms accurate)
+ * takes precedence over the LoRaWAN DeviceTimeAns (about 1 s accurate).
+ *
+ * Samples, log lines and uplinks carry a 32-bit epoch in seconds.
+ *
+ * Functions:
+ *  - @ref timekeeping_sync() / @ref timekeeping_sync_utc() to discipline the clock.
+ *  - @ref timekeeping_now() / @ref timekeeping_epoch_at() to timestamp events.
+ *  - @ref timekeeping_utc_to_unix() / @ref timekeeping_epoch_to_utc() for calendar conversions.
+ */
+
+#ifndef TIMEKEEPING_H
+#define TIMEKEEPING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sensors/gps/nmea.h"
+
+#define TIMEKEEPING_EPOCH_UNKNOWN  0       /**< Epoch returned while the clock is not set. */
+
+/**
+ * @brief Time sources, ordered by increasing accuracy.
+ */
+enum timekeeping_source {
+    TIMEKEEPING_SOURCE_NONE = 0,  /**< Clock not set. */
+    TIMEKEEPING_SOURCE_NETWORK,   /**< LoRaWAN DeviceTimeAns. */
+    TIMEKEEPING_SOURCE_GPS,       /**< GPS RMC date and time. */
+};
+
+/**
+ * @brief Sets the clock from a reference time.
+ *
+ * A less accurate source is ignored while a better one synchronized the
+ * clock recently. Successive GPS synchronizations also measure the drift
+ * of the uptime oscillator, which is then compensated between fixes.
+ *
+ * @param unix_ms Unix time in milliseconds.
+ * @param uptime Uptime (ms) at which @p unix_ms was valid.
+ * @param source Origin of @p unix_ms.
+ * @retval 0 If the clock was updated.
+ * @retval -EINVAL If the time is implausible (before @c TIMEKEEPING_MIN_YEAR).
+ * @retval -EALREADY If a more accurate source holds the clock.
+ */
+int timekeeping_sync(int64_t unix_ms, int64_t uptime, enum timekeeping_source source);
+
+/**
+ * @brief Sets the clock from a UTC date and time (e.g. a GPS RMC epoch).
+ *
+ * @param utc UTC date and time; the date must be known.
+ * @param uptime Uptime (ms) at which @p utc was valid.
+ * @param source Origin of @p utc.
+ * @return See @ref timekeeping_sync().
+ */
+int timekeeping_sync_utc(const struct gps_utc *utc, int64_t uptime, enum timekeeping_source source);
+
+/**
+ * @brief Returns the Unix epoch of an uptime instant.
+ *
+ * @param uptime Uptime in milliseconds (e.g. the time a sample was taken).
+ * @return Unix time in seconds, or @ref TIMEKEEPING_EPOCH_UNKNOWN if the clock is not set.
+ */
+uint32_t timekeeping_epoch_at(int64_t uptime);
+
+/**
+ * @brief Returns the current Unix epoch.
+ *
+ * @return Unix time in seconds, or @ref TIMEKEEPING_EPOCH_UNKNOWN if the clock is not set.
+ */
+uint32_t timekeeping_now(void);
+
+/**
+ * @brief Converts a UTC date and time to Unix time.
+ *
+ * @param utc UTC date and time.
+ * @param unix_ms Pointer to store the Unix time in milliseconds.
+ * @retval 0 On success.
+ * @retval -EINVAL If the date is unknown or invalid.
+ */
+int timekeeping_utc_to_unix(const struct gps_utc *utc, int64_t *unix_ms);
+
+/**
+ * @brief Converts a Unix epoch to a UTC date and time.
+ *
+ * @param epoch Unix time in seconds.
+ * @param utc Pointer to store the UTC date and time (milliseconds set to 0).
+ */
+void timekeeping_epoch_to_utc(uint32_t epoch, struct gps_utc *utc);
+
+#endif /* TIMEKEEPING_H */
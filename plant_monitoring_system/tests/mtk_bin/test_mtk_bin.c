@@ -0,0 +1,340 @@
+/**
+ * @file test_mtk_bin.c
+ * @brief Host unit tests of the MediaTek binary protocol and EPO upload.
+ *
+ * @ref mtk_epo_upload() is driven through a scripted stand-in for the
+ * receiver UART: every packet written is decoded and checked, and the
+ * script decides whether the receiver acknowledges it, drops the
+ * acknowledgement, answers with a stale sequence number or rejects it.
+ * Acknowledgements travel back as encoded bytes through
+ * @ref mtk_bin_process_byte(), as in the GPS driver.
+ */
+
+#include "mtk_bin.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+static int failures;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+#define MAX_WRITES  32   /**< Packets recorded by the stand-in. */
+#define IMAGE_SIZE  (7 * MTK_EPO_SV_SIZE) /**< Two full packets and one partial. */
+
+/** Receiver behaviour for one written packet. */
+enum reply {
+    REPLY_ACK = 0,   /**< Acknowledge with success. */
+    REPLY_DROP,      /**< Acknowledgement lost. */
+    REPLY_STALE,     /**< Only an acknowledgement of the previous sequence arrives. */
+    REPLY_NACK,      /**< Acknowledge with failure. */
+};
+
+/** Scripted receiver UART. */
+static struct {
+    enum reply script[MAX_WRITES];    /**< Reply to each write (default: REPLY_ACK). */
+    uint8_t written[MAX_WRITES][MTK_EPO_PACKET_SIZE];
+    uint16_t seq[MAX_WRITES];         /**< Sequence number of each written packet. */
+    size_t writes;
+    uint8_t rx[64];                   /**< Bytes waiting to be "received". */
+    size_t rx_len;
+    struct mtk_bin_parser parser;
+    int write_error;                  /**< Returned by the next write if non-zero. */
+} uart;
+
+static uint8_t image[IMAGE_SIZE];
+
+/** Queues an encoded acknowledgement, preceded by NMEA noise. */
+static void queue_ack(uint16_t seq, uint8_t result)
+{
+    const uint8_t payload[3] = { (uint8_t)(seq & 0xFF), (uint8_t)(seq >> 8), result };
+    static const char noise[] = "$GP";
+
+    memcpy(&uart.rx[uart.rx_len], noise, sizeof(noise) - 1);
+    uart.rx_len += sizeof(noise) - 1;
+    uart.rx_len += mtk_bin_encode(&uart.rx[uart.rx_len], sizeof(uart.rx) - uart.rx_len,
+                                  MTK_BIN_CMD_ACK, payload, sizeof(payload));
+}
+
+static int io_read(void *ctx, size_t offset, uint8_t *buf, size_t len)
+{
+    (void)ctx;
+    if (offset + len > sizeof(image)) return -EFAULT;
+    memcpy(buf, &image[offset], len);
+    return 0;
+}
+
+static int io_write(void *ctx, const uint8_t *buf, size_t len)
+{
+    (void)ctx;
+
+    if (uart.write_error) return uart.write_error;
+
+    CHECK(len == MTK_EPO_PACKET_SIZE);
+    CHECK(uart.writes < MAX_WRITES);
+    if (len != MTK_EPO_PACKET_SIZE || uart.writes >= MAX_WRITES) return -EIO;
+
+    size_t n = uart.writes++;
+    uint16_t seq = (uint16_t)(buf[6] | (buf[7] << 8));
+
+    memcpy(uart.written[n], buf, len);
+    uart.seq[n] = seq;
+
+    switch (uart.script[n]) {
+    case REPLY_ACK:
+        queue_ack(seq, 1);
+        break;
+    case REPLY_STALE:
+        queue_ack((uint16_t)(seq - 1), 1);
+        break;
+    case REPLY_NACK:
+        queue_ack(seq, 0);
+        break;
+    case REPLY_DROP:
+    default:
+        break;
+    }
+    return 0;
+}
+
+static int io_wait_ack(void *ctx, uint16_t *seq, uint8_t *result)
+{
+    (void)ctx;
+
+    for (size_t i = 0; i < uart.rx_len; i++) {
+        if (mtk_bin_process_byte(&uart.parser, uart.rx[i]) &&
+            uart.parser.cmd == MTK_BIN_CMD_ACK && uart.parser.payload_len >= 3) {
+            *seq = (uint16_t)(uart.parser.payload[0] | (uart.parser.payload[1] << 8));
+            *result = uart.parser.payload[2];
+            memmove(uart.rx, &uart.rx[i + 1], uart.rx_len - i - 1);
+            uart.rx_len -= i + 1;
+            return 0;
+        }
+    }
+    uart.rx_len = 0;
+    return -ETIMEDOUT;
+}
+
+static const struct mtk_epo_io io = {
+    .read = io_read,
+    .write = io_write,
+    .wait_ack = io_wait_ack,
+};
+
+static void reset_uart(void)
+{
+    memset(&uart, 0, sizeof(uart));
+    mtk_bin_parser_reset(&uart.parser);
+}
+
+/** Checks the framing of a written EPO packet and returns its payload. */
+static const uint8_t *check_epo_packet(const uint8_t *pkt, uint16_t seq)
+{
+    uint8_t checksum = 0;
+
+    for (size_t i = 2; i < MTK_EPO_PACKET_SIZE - 3; i++) {
+        checksum ^= pkt[i];
+    }
+    CHECK(pkt[0] == 0x04 && pkt[1] == 0x24);
+    CHECK((pkt[2] | (pkt[3] << 8)) == MTK_EPO_PACKET_SIZE);
+    CHECK((pkt[4] | (pkt[5] << 8)) == MTK_BIN_CMD_EPO_DATA);
+    CHECK((pkt[6] | (pkt[7] << 8)) == seq);
+    CHECK(pkt[MTK_EPO_PACKET_SIZE - 3] == checksum);
+    CHECK(pkt[MTK_EPO_PACKET_SIZE - 2] == 0x0D && pkt[MTK_EPO_PACKET_SIZE - 1] == 0x0A);
+    return &pkt[6];
+}
+
+static void test_encode(void)
+{
+    uint8_t payload[MTK_EPO_PAYLOAD_SIZE];
+    uint8_t pkt[MTK_EPO_PACKET_SIZE];
+
+    for (size_t i = 0; i < sizeof(payload); i++) {
+        payload[i] = (uint8_t)(i * 7 + 3);
+    }
+    payload[0] = 0x34;
+    payload[1] = 0x12;
+
+    CHECK(MTK_EPO_PACKET_SIZE == 191);
+    CHECK(mtk_bin_encode(pkt, sizeof(pkt), MTK_BIN_CMD_EPO_DATA, payload, sizeof(payload)) == 191);
+    CHECK(memcmp(check_epo_packet(pkt, 0x1234), payload, sizeof(payload)) == 0);
+
+    /* Binary format change back to NMEA, baud rate unchanged (fixed reference) */
+    const uint8_t fmt[5] = { 0x00, 0x00, 0x00, 0x00, 0x00 };
+    static const uint8_t expected[] = { 0x04, 0x24, 0x0E, 0x00, 0xFD, 0x00, 0x00, 0x00,
+                                        0x00, 0x00, 0x00, 0xF3, 0x0D, 0x0A };
+    CHECK(mtk_bin_encode(pkt, sizeof(pkt), MTK_BIN_CMD_SET_FORMAT, fmt, sizeof(fmt)) == sizeof(expected));
+    CHECK(memcmp(pkt, expected, sizeof(expected)) == 0);
+
+    /* Buffer too small */
+    CHECK(mtk_bin_encode(pkt, MTK_EPO_PACKET_SIZE - 1, MTK_BIN_CMD_EPO_DATA, payload, sizeof(payload)) == 0);
+}
+
+static void test_decode(void)
+{
+    struct mtk_bin_parser p;
+    uint8_t pkt[32];
+    const uint8_t ack[3] = { 0x05, 0x00, 0x01 };
+    size_t len = mtk_bin_encode(pkt, sizeof(pkt), MTK_BIN_CMD_ACK, ack, sizeof(ack));
+    int complete = 0;
+
+    /* Preceded by noise and a repeated first preamble byte */
+    mtk_bin_parser_reset(&p);
+    mtk_bin_process_byte(&p, 'x');
+    mtk_bin_process_byte(&p, 0x04);
+    for (size_t i = 0; i < len; i++) {
+        complete += mtk_bin_process_byte(&p, pkt[i]);
+    }
+    CHECK(complete == 1);
+    CHECK(p.cmd == MTK_BIN_CMD_ACK && p.payload_len == 3);
+    CHECK(memcmp(p.payload, ack, sizeof(ack)) == 0);
+
+    /* Corrupted checksum */
+    pkt[len - 3] ^= 0x01;
+    complete = 0;
+    mtk_bin_parser_reset(&p);
+    for (size_t i = 0; i < len; i++) {
+        complete += mtk_bin_process_byte(&p, pkt[i]);
+    }
+    CHECK(complete == 0);
+
+    /* Payload larger than the decoder accepts */
+    uint8_t big[MTK_BIN_MAX_RX_PAYLOAD + 1] = { 0 };
+    uint8_t big_pkt[sizeof(big) + MTK_BIN_OVERHEAD];
+    len = mtk_bin_encode(big_pkt, sizeof(big_pkt), MTK_BIN_CMD_ACK, big, sizeof(big));
+    complete = 0;
+    mtk_bin_parser_reset(&p);
+    for (size_t i = 0; i < len; i++) {
+        complete += mtk_bin_process_byte(&p, big_pkt[i]);
+    }
+    CHECK(complete == 0);
+}
+
+static void test_upload(void)
+{
+    const size_t chunk = MTK_EPO_SVS_PER_PACKET * MTK_EPO_SV_SIZE;
+
+    reset_uart();
+    CHECK(mtk_epo_upload(&io, sizeof(image)) == 0);
+
+    /* Three data packets, then the end packet */
+    CHECK(uart.writes == 4);
+    for (uint16_t seq = 0; seq < 3; seq++) {
+        const uint8_t *payload = check_epo_packet(uart.written[seq], seq);
+        size_t len = (seq < 2) ? chunk : sizeof(image) - 2 * chunk;
+
+        CHECK(memcmp(&payload[2], &image[seq * chunk], len) == 0);
+        for (size_t i = len; i < chunk; i++) {
+            CHECK(payload[2 + i] == 0);
+        }
+    }
+
+    const uint8_t *end = check_epo_packet(uart.written[3], MTK_EPO_SEQ_END);
+    for (size_t i = 2; i < MTK_EPO_PAYLOAD_SIZE; i++) {
+        CHECK(end[i] == 0);
+    }
+}
+
+static void test_retransmit(void)
+{
+    /* Dropped acknowledgement of packet 1 */
+    reset_uart();
+    uart.script[1] = REPLY_DROP;
+    CHECK(mtk_epo_upload(&io, sizeof(image)) == 0);
+    CHECK(uart.writes == 5);
+    CHECK(uart.seq[1] == 1 && uart.seq[2] == 1 && uart.seq[3] == 2);
+    CHECK(memcmp(uart.written[1], uart.written[2], MTK_EPO_PACKET_SIZE) == 0);
+    CHECK(uart.seq[4] == MTK_EPO_SEQ_END);
+
+    /* Only a late acknowledgement of packet 0 arrives for packet 1: skipped */
+    reset_uart();
+    uart.script[1] = REPLY_STALE;
+    CHECK(mtk_epo_upload(&io, sizeof(image)) == 0);
+    CHECK(uart.writes == 5);
+    CHECK(uart.seq[1] == 1 && uart.seq[2] == 1);
+
+    /* Rejected once, accepted on the retransmission */
+    reset_uart();
+    uart.script[0] = REPLY_NACK;
+    CHECK(mtk_epo_upload(&io, sizeof(image)) == 0);
+    CHECK(uart.writes == 5);
+    CHECK(uart.seq[0] == 0 && uart.seq[1] == 0);
+
+    /* Lost acknowledgement of the end packet */
+    reset_uart();
+    uart.script[3] = REPLY_DROP;
+    CHECK(mtk_epo_upload(&io, sizeof(image)) == 0);
+    CHECK(uart.writes == 5);
+    CHECK(uart.seq[3] == MTK_EPO_SEQ_END && uart.seq[4] == MTK_EPO_SEQ_END);
+}
+
+static void test_give_up(void)
+{
+    /* Never acknowledged */
+    reset_uart();
+    for (int i = 0; i < MTK_EPO_MAX_RETRIES; i++) {
+        uart.script[1 + i] = REPLY_DROP;
+    }
+    CHECK(mtk_epo_upload(&io, sizeof(image)) == -ETIMEDOUT);
+    CHECK(uart.writes == 1 + MTK_EPO_MAX_RETRIES);
+
+    /* Only stale acknowledgements */
+    reset_uart();
+    for (int i = 0; i < MTK_EPO_MAX_RETRIES; i++) {
+        uart.script[1 + i] = REPLY_STALE;
+    }
+    CHECK(mtk_epo_upload(&io, sizeof(image)) == -ETIMEDOUT);
+    CHECK(uart.writes == 1 + MTK_EPO_MAX_RETRIES);
+
+    /* Rejected on every attempt */
+    reset_uart();
+    for (int i = 0; i < MTK_EPO_MAX_RETRIES; i++) {
+        uart.script[i] = REPLY_NACK;
+    }
+    CHECK(mtk_epo_upload(&io, sizeof(image)) == -EIO);
+    CHECK(uart.writes == MTK_EPO_MAX_RETRIES);
+
+    /* I/O errors are returned as is */
+    reset_uart();
+    uart.write_error = -EBUSY;
+    CHECK(mtk_epo_upload(&io, sizeof(image)) == -EBUSY);
+}
+
+static void test_invalid_length(void)
+{
+    reset_uart();
+    CHECK(mtk_epo_upload(&io, 0) == -EINVAL);
+    CHECK(mtk_epo_upload(&io, MTK_EPO_SV_SIZE - 1) == -EINVAL);
+    CHECK(mtk_epo_upload(&io, MTK_EPO_SV_SIZE + 1) == -EINVAL);
+    CHECK(mtk_epo_upload(&io, MTK_EPO_SEGMENT_SIZE + 30) == -EINVAL);
+    CHECK(uart.writes == 0);
+
+    /* A single record is valid */
+    CHECK(mtk_epo_upload(&io, MTK_EPO_SV_SIZE) == 0);
+    CHECK(uart.writes == 2);
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+
+    for (size_t i = 0; i < sizeof(image); i++) {
+        image[i] = (uint8_t)(i * 31 + 7);
+    }
+
+    test_encode();
+    test_decode();
+    test_upload();
+    test_retransmit();
+    test_give_up();
+    test_invalid_length();
+
+    printf("%s: %d failure(s)\n", argv[0], failures);
+    return failures ? 1 : 0;
+}
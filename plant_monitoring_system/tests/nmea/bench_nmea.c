@@ -0,0 +1,72 @@
+/**
+ * @file bench_nmea.c
+ * @brief Host throughput benchmark of the streaming NMEA parser.
+ *
+ * Replays a recorded receiver log through @ref nmea_process_byte() a number
+ * of times and prints the parsing throughput.
+ *
+ * Usage: bench_nmea <log.nmea> [passes]
+ */
+
+#include "nmea.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_DEFAULT_PASSES 1000  /**< Replays of the log when not given. */
+
+static unsigned long fixes;
+
+static void on_fix(const gps_data_t *fix, void *user_data)
+{
+    (void)fix;
+    (void)user_data;
+    fixes++;
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv)
+{
+    static uint8_t buf[1024 * 1024];
+    struct nmea_parser p;
+
+    if (argc < 2) {
+        printf("usage: %s <log.nmea> [passes]\n", argv[0]);
+        return 2;
+    }
+    long passes = (argc > 2) ? strtol(argv[2], NULL, 10) : BENCH_DEFAULT_PASSES;
+
+    FILE *f = fopen(argv[1], "rb");
+    if (f == NULL) {
+        perror(argv[1]);
+        return 2;
+    }
+    size_t len = fread(buf, 1, sizeof(buf), f);
+    fclose(f);
+    if (len == 0 || passes <= 0) {
+        printf("%s: empty log or invalid pass count\n", argv[0]);
+        return 2;
+    }
+
+    nmea_parser_init(&p, on_fix, NULL, NULL);
+
+    double start = now_s();
+    for (long pass = 0; pass < passes; pass++) {
+        for (size_t i = 0; i < len; i++) {
+            nmea_process_byte(&p, buf[i]);
+        }
+    }
+    double elapsed = now_s() - start;
+
+    double bytes = (double)len * passes;
+    printf("%zu bytes x %ld passes in %.3f s: %.1f MB/s, %.0f bytes/s, %lu fixes\n",
+           len, passes, elapsed, bytes / elapsed / 1e6, bytes / elapsed, fixes);
+    return 0;
+}
@@ -0,0 +1,47 @@
+/**
+ * @file fuzz_nmea.c
+ * @brief libFuzzer/AFL harness of the streaming NMEA parser.
+ *
+ * The first input byte selects the expected sentences of an epoch; the rest
+ * is fed byte by byte to @ref nmea_process_byte(). Every published fix is
+ * read completely, so sanitizers see any uninitialized or out-of-bounds
+ * data handed to the callbacks.
+ */
+
+#include "nmea.h"
+#include <stddef.h>
+#include <stdint.h>
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+static volatile uint32_t sink;
+
+static void on_fix(const gps_data_t *fix, void *user_data)
+{
+    (void)user_data;
+    sink ^= fix->seq ^ fix->sentences ^ (uint32_t)fix->lat ^ (uint32_t)fix->lon ^
+            (uint32_t)fix->alt ^ (uint32_t)fix->sats ^ fix->fix_quality ^ fix->fix_mode ^
+            fix->valid ^ fix->hdop ^ fix->pdop ^ fix->vdop ^ fix->speed ^ fix->course ^
+            fix->utc.year ^ fix->utc.month ^ fix->utc.day ^ fix->utc.hour ^
+            fix->utc.minute ^ fix->utc.second ^ fix->utc.msec;
+}
+
+static void on_ack(uint16_t cmd, uint8_t flag, void *user_data)
+{
+    (void)user_data;
+    sink ^= cmd ^ flag;
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    struct nmea_parser p;
+
+    nmea_parser_init(&p, on_fix, on_ack, NULL);
+    if (size == 0) return 0;
+
+    nmea_set_expected(&p, data[0]);
+    for (size_t i = 1; i < size; i++) {
+        nmea_process_byte(&p, data[i]);
+    }
+    return 0;
+}
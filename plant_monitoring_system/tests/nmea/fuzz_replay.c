@@ -0,0 +1,39 @@
+/**
+ * @file fuzz_replay.c
+ * @brief Runs a libFuzzer entry point on inputs given as files.
+ *
+ * Used without libFuzzer: replays a corpus or crash reproducers under any
+ * compiler, and serves as the AFL driver ("fuzz_nmea_replay @@").
+ *
+ * Usage: fuzz_nmea_replay <input>...
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+int main(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++) {
+        FILE *f = fopen(argv[i], "rb");
+        if (f == NULL) {
+            perror(argv[i]);
+            return 2;
+        }
+
+        fseek(f, 0, SEEK_END);
+        long len = ftell(f);
+        fseek(f, 0, SEEK_SET);
+
+        uint8_t *data = malloc(len > 0 ? (size_t)len : 1);
+        size_t got = (data != NULL) ? fread(data, 1, (size_t)len, f) : 0;
+        fclose(f);
+
+        LLVMFuzzerTestOneInput(data, got);
+        free(data);
+        printf("%s: %zu bytes\n", argv[i], got);
+    }
+    return 0;
+}
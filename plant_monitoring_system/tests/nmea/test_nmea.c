@@ -0,0 +1,196 @@
+/**
+ * @file test_nmea.c
+ * @brief Host unit tests of the streaming NMEA parser.
+ *
+ * Replays the recorded receiver log given on the command line and feeds
+ * hand-written sentences to check field conversions, epoch fusion,
+ * checksum validation and PMTK001 decoding.
+ *
+ * Usage: test_nmea <log.nmea>
+ */
+
+#include "nmea.h"
+#include <stdio.h>
+#include <string.h>
+
+static int failures;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+/** Fixes and acknowledgements received from the parser. */
+static struct {
+    unsigned int fixes;
+    unsigned int valid_fixes;
+    gps_data_t first_valid;
+    gps_data_t last;
+    unsigned int acks;
+    uint16_t ack_cmd[4];
+    uint8_t ack_flag[4];
+} rx;
+
+static void on_fix(const gps_data_t *fix, void *user_data)
+{
+    (void)user_data;
+
+    if (fix->valid && rx.valid_fixes++ == 0) {
+        rx.first_valid = *fix;
+    }
+    rx.last = *fix;
+    rx.fixes++;
+}
+
+static void on_ack(uint16_t cmd, uint8_t flag, void *user_data)
+{
+    (void)user_data;
+
+    if (rx.acks < 4) {
+        rx.ack_cmd[rx.acks] = cmd;
+        rx.ack_flag[rx.acks] = flag;
+    }
+    rx.acks++;
+}
+
+/** Feeds a string to a freshly initialized parser expecting @p sentences per epoch. */
+static void feed(struct nmea_parser *p, uint8_t sentences, const char *s)
+{
+    memset(&rx, 0, sizeof(rx));
+    nmea_parser_init(p, on_fix, on_ack, NULL);
+    nmea_set_expected(p, sentences);
+    for (; *s; s++) {
+        nmea_process_byte(p, (uint8_t)*s);
+    }
+}
+
+static void test_parse_fixed(void)
+{
+    int32_t v = 0;
+
+    CHECK(nmea_parse_fixed("545.4", 2, &v) && v == 54540);
+    CHECK(nmea_parse_fixed("-12.05", 2, &v) && v == -1205);
+    CHECK(nmea_parse_fixed("0.987", 2, &v) && v == 98);
+    CHECK(nmea_parse_fixed("7", 0, &v) && v == 7);
+    CHECK(!nmea_parse_fixed("", 2, &v));
+    CHECK(!nmea_parse_fixed(".", 2, &v));
+    CHECK(!nmea_parse_fixed("1.2.3", 2, &v));
+    CHECK(!nmea_parse_fixed("12a", 0, &v));
+    CHECK(!nmea_parse_fixed("99999999999", 0, &v));
+}
+
+static void test_parse_coord(void)
+{
+    int32_t v = 0;
+
+    CHECK(nmea_parse_coord("4024.4327", 'N', &v) && v == 40407212);
+    CHECK(nmea_parse_coord("00341.6572", 'W', &v) && v == -3694287);
+    CHECK(nmea_parse_coord("0000.0000", 'S', &v) && v == 0);
+    CHECK(!nmea_parse_coord("4024.4327", 'X', &v));
+    CHECK(!nmea_parse_coord("4060.0000", 'N', &v));
+    CHECK(!nmea_parse_coord("9100.0000", 'N', &v));
+    CHECK(!nmea_parse_coord("12", 'N', &v));
+    CHECK(!nmea_parse_coord("4024.43x7", 'N', &v));
+}
+
+static void test_log(const char *path)
+{
+    static char buf[64 * 1024];
+    struct nmea_parser p;
+    FILE *f = fopen(path, "rb");
+
+    CHECK(f != NULL);
+    if (f == NULL) return;
+
+    size_t len = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+    buf[len] = '\0';
+
+    feed(&p, GPS_SENTENCE_ALL, buf);
+
+    /* 5 epochs without a fix, then 60 with a 3D fix */
+    CHECK(rx.fixes == 65);
+    CHECK(rx.valid_fixes == 60);
+    CHECK(rx.first_valid.sentences == GPS_SENTENCE_ALL);
+    CHECK(rx.first_valid.lat == 40407212);
+    CHECK(rx.first_valid.lon == -3694287);
+    CHECK(rx.first_valid.alt == 65550);
+    CHECK(rx.first_valid.sats == 9);
+    CHECK(rx.first_valid.fix_quality == 1);
+    CHECK(rx.first_valid.fix_mode == 3);
+    CHECK(rx.first_valid.hdop == 95);
+    CHECK(rx.first_valid.pdop == 125);
+    CHECK(rx.first_valid.vdop == 85);
+    CHECK(rx.first_valid.speed == 5);
+    CHECK(rx.first_valid.course == 2515);
+    CHECK(rx.first_valid.utc.year == 2026 && rx.first_valid.utc.month == 10 &&
+          rx.first_valid.utc.day == 16);
+    CHECK(rx.first_valid.utc.hour == 8 && rx.first_valid.utc.minute == 15 &&
+          rx.first_valid.utc.second == 5);
+    CHECK(rx.last.seq == 65);
+
+    /* Only PMTK001 is decoded */
+    CHECK(rx.acks == 2);
+    CHECK(rx.ack_cmd[0] == 314 && rx.ack_flag[0] == 3);
+    CHECK(rx.ack_cmd[1] == 220 && rx.ack_flag[1] == 3);
+}
+
+static void test_sentences(void)
+{
+    struct nmea_parser p;
+
+    /* A lone GGA is published when the next epoch starts */
+    feed(&p, GPS_SENTENCE_ALL,
+         "$GPGGA,120000.000,4024.4327,N,00341.6572,W,1,09,0.95,655.5,M,51.6,M,,*79\r\n"
+         "$GPGGA,120001,4024.4327,N,00341.6572,W,1,09,0.95,655.5,M,51.6,M,,*66\r\n");
+    CHECK(rx.fixes == 1);
+    CHECK(rx.last.sentences == GPS_SENTENCE_GGA);
+    CHECK(rx.last.utc.second == 0);
+
+    /* Checksum mismatch */
+    feed(&p, GPS_SENTENCE_GGA,
+         "$GPGGA,120000.000,4024.4327,N,00341.6572,W,1,09,0.95,655.5,M,51.6,M,,*78\r\n");
+    CHECK(rx.fixes == 0);
+
+    /* Time without fraction, then trailing characters after the seconds */
+    feed(&p, GPS_SENTENCE_GGA,
+         "$GPGGA,120001,4024.4327,N,00341.6572,W,1,09,0.95,655.5,M,51.6,M,,*66\r\n");
+    CHECK(rx.fixes == 1 && rx.last.utc.second == 1 && rx.last.utc.msec == 0);
+    feed(&p, GPS_SENTENCE_GGA,
+         "$GPGGA,120000X,4024.4327,N,00341.6572,W,1,09,0.95,655.5,M,51.6,M,,*3F\r\n");
+    CHECK(rx.fixes == 0);
+    feed(&p, GPS_SENTENCE_GGA,
+         "$GPGGA,120000.5Z,4024.4327,N,00341.6572,W,1,09,0.95,655.5,M,51.6,M,,*26\r\n");
+    CHECK(rx.fixes == 0);
+
+    /* Unsupported talker and sentence, PMTK001 acknowledgement */
+    feed(&p, GPS_SENTENCE_ALL, "$PGRMZ,246,f,3*1B\r\n$GPGSV,1,1,00*79\r\n$PMTK001,604,2*33\r\n");
+    CHECK(rx.fixes == 0);
+    CHECK(rx.acks == 1 && rx.ack_cmd[0] == 604 && rx.ack_flag[0] == 2);
+
+    /* Oversized sentence */
+    char longer[NMEA_BUF_SIZE + 32] = "$GPGGA,120000.000";
+    memset(&longer[17], ',', sizeof(longer) - 18);
+    longer[sizeof(longer) - 1] = '\0';
+    feed(&p, GPS_SENTENCE_GGA, longer);
+    CHECK(rx.fixes == 0);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        printf("usage: %s <log.nmea>\n", argv[0]);
+        return 2;
+    }
+
+    test_parse_fixed();
+    test_parse_coord();
+    test_log(argv[1]);
+    test_sentences();
+
+    printf("%s: %d failure(s)\n", argv[0], failures);
+    return failures ? 1 : 0;
+}